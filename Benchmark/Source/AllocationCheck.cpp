@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    AllocationCheck.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "../../SpectralFreeze/Source/BatchFFT/BatchFFT.h"
+#include "../../SpectralFreeze/Source/FreezeBank/FreezeBank.h"
+#include "../../SpectralFreeze/Source/GeometrySwitcher/GeometrySwitcher.h"
+#include "../../SpectralFreeze/Source/JVFreezer/JVFreezer.h"
+#include "../../SpectralFreeze/Source/MultiResolutionFreezer/MultiResolutionFreezer.h"
+#include "../../SpectralFreeze/Source/PhaseVocodeur3/PhaseVocodeur3.h"
+#include "../../SpectralFreeze/Source/PlanCache/PlanCache.h"
+#include "../../SpectralFreeze/Source/SpectrumSnapshot/SpectrumSnapshot.h"
+
+/* --check-allocations: each engine's process() live, then frozen, in
+   blocks of 512 and of 100 samples (aligned with the hop and not), from
+   its first block on. Freezing, capturing and morphing happen inside the
+   counted calls, as they would in processBlock. */
+
+bool check_allocations()
+{
+    std::printf("audio thread allocations, live and frozen\n");
+    std::printf("%-28s %10s %10s\n", "engine", "live", "frozen");
+    
+    const int max_channels = 4;
+    const int blocks_per_size = 200;
+    
+    juce::Random random (4321);
+    std::vector<std::vector<float> > input (max_channels, std::vector<float> (512));
+    std::vector<std::vector<float> > output = input;
+    for (auto &channel : input)
+        for (auto &x : channel)
+            x = random.nextFloat() * 2.0f - 1.0f;
+    const float *r[max_channels];
+    float *w[max_channels];
+    for (int c = 0; c < max_channels; c++)
+    {
+        r[c] = &input[c][0];
+        w[c] = &output[c][0];
+    }
+    
+    bool passed = true;
+    
+    /* set_frozen(frozen) before each half, then process in both block sizes */
+    auto check = [&] (const char *name, std::function<void(bool)> set_frozen, BlockProcess process)
+    {
+        long counts[2];
+        for (bool frozen : {false, true})
+        {
+            counts[frozen] = count_allocations([&]
+            {
+                set_frozen(frozen);
+                for (int block_size : {512, 100})
+                    for (int b = 0; b < blocks_per_size; b++)
+                        process(r, w, block_size);
+            });
+        }
+        bool ok = (counts[0] == 0 && counts[1] == 0);
+        std::printf("%-28s %10ld %10ld%s\n", name, counts[0], counts[1], ok ? "" : "  FAILED");
+        passed = passed && ok;
+    };
+    
+    {
+        JVFreezer freezer;
+        check("JVFreezer",
+              [&] (bool frozen) { freezer.set_is_freeze_active(frozen); },
+              [&] (const float *const *in, float *const *out, int n) { freezer.process(in[0], out[0], n); });
+    }
+    {
+        JVFreezer freezer;
+        freezer.set_low_latency(true);
+        check("JVFreezer low latency",
+              [&] (bool frozen) { freezer.set_is_freeze_active(frozen); },
+              [&] (const float *const *in, float *const *out, int n) { freezer.process(in[0], out[0], n); });
+    }
+    {
+        // captures the live sound, then morphs from the freeze into it
+        JVFreezer freezer;
+        FreezeBank bank (1, 1, freezer.get_n_fft()/2 + 1);
+        freezer.set_freeze_bank(&bank, 0);
+        check("JVFreezer bank morph",
+              [&] (bool frozen)
+              {
+                  freezer.capture_to_bank(0);
+                  freezer.set_is_freeze_active(frozen);
+                  freezer.set_bank_morph(-1, 0, 0.5f);
+              },
+              [&] (const float *const *in, float *const *out, int n) { freezer.process(in[0], out[0], n); });
+    }
+    {
+        JVFreezer f[2];
+        check("JVFreezer pair",
+              [&] (bool frozen) { for (auto &freezer : f) freezer.set_is_freeze_active(frozen); },
+              [&] (const float *const *in, float *const *out, int n)
+              {
+                  f[0].process_pair(f[1], in[0], in[1], out[0], out[1], n);
+              });
+    }
+    {
+        JVFreezer f[4];
+        BatchFFT batch (f[0].get_n_fft());
+        PhaseVocodeur3 *engines[4] = {&f[0], &f[1], &f[2], &f[3]};
+        check("JVFreezer batch",
+              [&] (bool frozen) { for (auto &freezer : f) freezer.set_is_freeze_active(frozen); },
+              [&] (const float *const *in, float *const *out, int n)
+              {
+                  PhaseVocodeur3::process_batch(batch, engines, in, out, 4, n);
+              });
+    }
+    {
+        // a new fft size every 32 blocks, given time to be built in the
+        // background (whose allocations aren't counted)
+        GeometrySwitcher<JVFreezer> switcher (max_channels, GeometrySwitcher<JVFreezer>::Geometry {1024, 256, 1024, false});
+        int blocks = 0;
+        check("JVFreezer switching",
+              [&] (bool frozen)
+              {
+                  switcher.for_each_engine([frozen] (JVFreezer &freezer) { freezer.set_is_freeze_active(frozen); });
+              },
+              [&] (const float *const *in, float *const *out, int n)
+              {
+                  if (++blocks % 32 == 0)
+                  {
+                      int n_fft = (blocks / 32) % 2 ? 2048 : 1024;
+                      switcher.request_geometry(n_fft, n_fft/4, n_fft);
+                  }
+                  switcher.process(in, out, max_channels, n);
+                  std::this_thread::sleep_for(std::chrono::milliseconds (1));
+              });
+    }
+    {
+        // SpectralFreezeAudioProcessor::processBlock's calls, as it makes
+        // them on parameter changes: freeze through for_each_engine, fft
+        // size and latency mode, window type, capture into the bank, and
+        // the bank morph every block, for every channel
+        GeometrySwitcher<JVFreezer> freezers (max_channels, GeometrySwitcher<JVFreezer>::Geometry {1024, 256, 1024, false});
+        FreezeBank bank (8, max_channels, 4096/2 + 1);
+        SpectrumSnapshot snapshot (4096/2 + 1);
+        freezers.get_engine(0).set_magnitude_snapshot(&snapshot);
+        for (int channel = 0; channel < max_channels; channel++)
+            freezers.get_engine(channel).set_freeze_bank(&bank, channel);
+        int blocks = 0;
+        check("SpectralFreeze processBlock",
+              [&] (bool frozen)
+              {
+                  freezers.for_each_engine([frozen] (JVFreezer &freezer) { freezer.set_is_freeze_active(frozen); });
+              },
+              [&] (const float *const *in, float *const *out, int n)
+              {
+                  blocks++;
+                  if (blocks % 64 == 0)
+                  {
+                      int n_fft = (blocks / 64) % 2 ? 2048 : 1024;
+                      freezers.request_geometry(n_fft, n_fft/4, n_fft, (blocks / 128) % 2 != 0);
+                  }
+                  if (blocks % 16 == 0)
+                  {
+                      auto window_type = static_cast<plan_cache::WindowType>((blocks / 16) % plan_cache::num_analysis_types);
+                      freezers.for_each_engine([window_type] (JVFreezer &freezer) { freezer.set_window_type(window_type); });
+                  }
+                  if (blocks % 8 == 0)
+                  {
+                      for (int channel = 0; channel < max_channels; channel++)
+                          freezers.get_engine(channel).capture_to_bank((blocks / 8) % 8);
+                  }
+                  int from = (blocks / 32) % 2 ? -1 : 0;
+                  float morph = static_cast<float>(blocks % 64) / 63.0f;
+                  freezers.for_each_engine([from, morph] (JVFreezer &freezer) { freezer.set_bank_morph(from, 1, morph); });
+                  
+                  freezers.process(in, out, max_channels, n);
+                  std::this_thread::sleep_for(std::chrono::milliseconds (1));
+              });
+    }
+    {
+        MultiResolutionFreezer multi_resolution (sample_rate);
+        check("MultiResolutionFreezer",
+              [&] (bool frozen) { multi_resolution.set_is_freeze_active(frozen); },
+              [&] (const float *const *in, float *const *out, int n) { multi_resolution.process(in[0], out[0], n); });
+    }
+    
+    std::printf(passed ? "passed\n" : "FAILED: allocations on the audio thread\n");
+    return passed;
+}
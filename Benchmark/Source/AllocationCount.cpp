@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    AllocationCount.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+        The benchmark's replacements of operator new and the aligned C
+        allocators, counting calls on a thread while it asks them to.
+
+    In a file of their own: where the replaced operator delete (free) is
+    inlined next to an operator new, gcc's -Wmismatched-new-delete takes
+    free() for a mismatch, although this operator new returns malloc's.
+    Defined out of line here, they can't be inlined into their callers,
+    and nothing in this file allocates.
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#include "Measure.h"
+
+/* count operator new on the measuring thread while a measurement runs
+   (background threads, like GeometrySwitcher's, may allocate). With
+   RT_GUARD the guard replaces operator new, so its violations
+   (allocations and locks) are counted instead, and printed with their
+   scope tags at the end. Aligned allocations count too: the aligned
+   operator new, and on glibc posix_memalign, aligned_alloc and memalign,
+   which boost::alignment::aligned_alloc (aligned_vector, FixedVocodeur)
+   goes through. Elsewhere only RT_GUARD sees those. */
+
+#if ! RT_GUARD
+static thread_local bool counting_allocations {false};
+static std::atomic<long> allocation_count {0};
+
+void start_counting_allocations()
+{
+    allocation_count = 0;
+    counting_allocations = true;
+}
+
+long stop_counting_allocations()
+{
+    counting_allocations = false;
+    return allocation_count.load();
+}
+
+static inline void count_allocation()
+{
+    if (counting_allocations)
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void* __libc_memalign(size_t alignment, size_t size);
+    
+    int posix_memalign(void **p, size_t alignment, size_t size)
+    {
+        count_allocation();
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+        *p = __libc_memalign(alignment, size);
+        return *p != nullptr ? 0 : ENOMEM;
+    }
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        count_allocation();
+        return __libc_memalign(alignment, size);
+    }
+    void* memalign(size_t alignment, size_t size)
+    {
+        count_allocation();
+        return __libc_memalign(alignment, size);
+    }
+}
+#endif
+
+void* operator new (std::size_t size)
+{
+    count_allocation();
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void operator delete (void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[] (void *p) noexcept               { operator delete (p); }
+void operator delete (void *p, std::size_t) noexcept    { operator delete (p); }
+void operator delete[] (void *p, std::size_t) noexcept  { operator delete (p); }
+
+#if __cpp_aligned_new
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    count_allocation();
+    std::size_t a = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+   #if defined(_WIN32)
+    void *p = _aligned_malloc(size == 0 ? 1 : size, a);
+   #elif defined(__GLIBC__)
+    void *p = __libc_memalign(a, size == 0 ? 1 : size);
+   #else
+    void *p = nullptr;
+    if (posix_memalign(&p, a, size == 0 ? 1 : size) != 0)
+        p = nullptr;
+   #endif
+    if (p != nullptr)
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return operator new (size, alignment);
+}
+
+void operator delete (void *p, std::align_val_t) noexcept
+{
+   #if defined(_WIN32)
+    _aligned_free(p);
+   #else
+    std::free(p);
+   #endif
+}
+
+void operator delete[] (void *p, std::align_val_t alignment) noexcept               { operator delete (p, alignment); }
+void operator delete (void *p, std::size_t, std::align_val_t alignment) noexcept    { operator delete (p, alignment); }
+void operator delete[] (void *p, std::size_t, std::align_val_t alignment) noexcept  { operator delete (p, alignment); }
+#endif
+#endif
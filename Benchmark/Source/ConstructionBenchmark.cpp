@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ConstructionBenchmark.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../../stutterhold/Source/PhaseVocodeur/PhaseVocodeur.h"
+#include "../../SpectralFreeze/Source/JVFreezer/JVFreezer.h"
+#include "../../SpectralFreeze/Source/PhaseVocodeur3/PhaseVocodeur3.h"
+#include "../../SpectralFreeze/Source/PlanCache/PlanCache.h"
+
+/* construction: num_instances engines built one after another, as a session
+   loading many plugin instances does. The first PhaseVocodeur3 builds the
+   cached plans and window, the others only look them up. */
+
+template <class Engine>
+static void print_construction_row(const char *name, std::function<Engine*()> create)
+{
+    const int num_instances = 64;
+    std::vector<std::unique_ptr<Engine> > engines;
+    
+    auto start = std::chrono::steady_clock::now();
+    engines.emplace_back(create());
+    auto first = std::chrono::steady_clock::now();
+    for (int i = 1; i < num_instances; i++)
+        engines.emplace_back(create());
+    auto end = std::chrono::steady_clock::now();
+    
+    double first_us = std::chrono::duration<double, std::micro>(first - start).count();
+    double rest_us = std::chrono::duration<double, std::micro>(end - first).count() / (num_instances - 1);
+    std::printf("%-22s %12.1f %12.1f %10d\n", name, first_us, rest_us, plan_cache::get_num_entries());
+}
+
+void benchmark_construction()
+{
+    std::printf("\nconstruction, 64 instances\n");
+    std::printf("%-22s %12s %12s %10s\n", "engine", "first us", "next us", "cached");
+    print_construction_row<PhaseVocodeur>("PhaseVocodeur", [] { return new PhaseVocodeur (1024, 256, 2048); });
+    print_construction_row<PhaseVocodeur3>("PhaseVocodeur3", [] { return new PhaseVocodeur3 (1024, 256, 2048); });
+    print_construction_row<JVFreezer>("JVFreezer", [] { return new JVFreezer (); });
+}
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    EnginesBenchmark.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "../../stutterhold/Source/PhaseVocodeur/PhaseVocodeur.h"
+#include "../../SpectralFreeze/Source/BatchFFT/BatchFFT.h"
+#include "../../SpectralFreeze/Source/FreezeBank/FreezeBank.h"
+#include "../../SpectralFreeze/Source/GeometrySwitcher/GeometrySwitcher.h"
+#include "../../SpectralFreeze/Source/JVFreezer/JVFreezer.h"
+#include "../../SpectralFreeze/Source/PhaseVocodeur3/PhaseVocodeur3.h"
+
+/* the engine table: each engine over a matrix of geometries, one hop per
+   block, then JVFreezer's modes and multichannel forms */
+
+void benchmark_engines(double seconds)
+{
+    struct Geometry { int frame_size, hop_size, n_fft; };
+    const Geometry matrix[] = {
+        {256,   64,   512},
+        {512,   128,  1024},
+        {1024,  256,  1024},
+        {1024,  256,  2048},
+        {2048,  512,  4096},
+    };
+    
+    print_header();
+    
+    // single channel engines across the matrix
+    for (auto g : matrix)
+    {
+        PhaseVocodeur pv (g.frame_size, g.hop_size, g.n_fft);
+        print_row("PhaseVocodeur", g.frame_size, g.hop_size, g.n_fft, 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { pv.process(in[0], out[0], n); },
+                          1, g.hop_size, seconds));
+        
+        PhaseVocodeur3 pv3 (g.frame_size, g.hop_size, g.n_fft);
+        print_row("PhaseVocodeur3", g.frame_size, g.hop_size, g.n_fft, 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { pv3.process(in[0], out[0], n); },
+                          1, g.hop_size, seconds));
+        
+        // the same geometry without the compile-time specialization
+        if (pv3.is_fixed_vocodeur_active())
+        {
+            PhaseVocodeur3 runtime (g.frame_size, g.hop_size, g.n_fft);
+            runtime.set_use_fixed_vocodeur(false);
+            print_row("PhaseVocodeur3 runtime", g.frame_size, g.hop_size, g.n_fft, 1,
+                      measure([&] (const float *const *in, float *const *out, int n) { runtime.process(in[0], out[0], n); },
+                              1, g.hop_size, seconds));
+        }
+    }
+    
+    // JVFreezer at the plugin's default geometry, also in low latency
+    for (bool frozen : {false, true})
+    {
+        JVFreezer freezer;
+        freezer.set_is_freeze_active(frozen);
+        print_row(frozen ? "JVFreezer frozen" : "JVFreezer", freezer.get_frame_size(), freezer.get_hop_size(),
+                  freezer.get_n_fft(), 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { freezer.process(in[0], out[0], n); },
+                          1, freezer.get_hop_size(), seconds));
+        
+        JVFreezer low_latency;
+        low_latency.set_low_latency(true);
+        low_latency.set_is_freeze_active(frozen);
+        print_row(frozen ? "JVFreezer low lat frozen" : "JVFreezer low latency", low_latency.get_frame_size(),
+                  low_latency.get_hop_size(), low_latency.get_n_fft(), 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { low_latency.process(in[0], out[0], n); },
+                          1, low_latency.get_hop_size(), seconds));
+    }
+    
+    // frozen from two captured noise spectra, the morph moving every hop
+    {
+        JVFreezer freezer;
+        FreezeBank bank (2, 1, freezer.get_n_fft()/2 + 1);
+        freezer.set_freeze_bank(&bank, 0);
+        
+        juce::Random random (5678);
+        std::vector<float> noise (4 * freezer.get_n_fft());
+        for (int slot = 0; slot < 2; slot++)
+        {
+            for (auto &x : noise)
+                x = random.nextFloat() * 2.0f - 1.0f;
+            freezer.process(&noise[0], &noise[0], static_cast<int>(noise.size()));
+            freezer.capture_to_bank(slot);
+        }
+        freezer.set_is_freeze_active(true);
+        
+        int hops = 0;
+        print_row("JVFreezer bank morph", freezer.get_frame_size(), freezer.get_hop_size(), freezer.get_n_fft(), 1,
+                  measure([&] (const float *const *in, float *const *out, int n)
+                          {
+                              freezer.set_bank_morph(0, 1, static_cast<float>(hops++ % 64) / 63.0f);
+                              freezer.process(in[0], out[0], n);
+                          }, 1, freezer.get_hop_size(), seconds));
+    }
+    
+    // multichannel: one engine per channel, pairs, and four-wide batches
+    for (bool frozen : {false, true})
+    {
+        JVFreezer f[4];
+        for (auto &freezer : f)
+            freezer.set_is_freeze_active(frozen);
+        BatchFFT batch (f[0].get_n_fft());
+        PhaseVocodeur3 *engines[4] = {&f[0], &f[1], &f[2], &f[3]};
+        
+        int frame_size = f[0].get_frame_size(), hop_size = f[0].get_hop_size(), n_fft = f[0].get_n_fft();
+        
+        print_row(frozen ? "JVFreezer x2 frozen" : "JVFreezer x2", frame_size, hop_size, n_fft, 2,
+                  measure([&] (const float *const *in, float *const *out, int n)
+                          {
+                              f[0].process(in[0], out[0], n);
+                              f[1].process(in[1], out[1], n);
+                          }, 2, hop_size, seconds));
+        print_row(frozen ? "JVFreezer pair frozen" : "JVFreezer pair", frame_size, hop_size, n_fft, 2,
+                  measure([&] (const float *const *in, float *const *out, int n)
+                          {
+                              f[0].process_pair(f[1], in[0], in[1], out[0], out[1], n);
+                          }, 2, hop_size, seconds));
+        print_row(frozen ? "JVFreezer x4 frozen" : "JVFreezer x4", frame_size, hop_size, n_fft, 4,
+                  measure([&] (const float *const *in, float *const *out, int n)
+                          {
+                              for (int c = 0; c < 4; c++)
+                                  f[c].process(in[c], out[c], n);
+                          }, 4, hop_size, seconds));
+        print_row(frozen ? "JVFreezer batch frozen" : "JVFreezer batch", frame_size, hop_size, n_fft, 4,
+                  measure([&] (const float *const *in, float *const *out, int n)
+                          {
+                              PhaseVocodeur3::process_batch(batch, engines, in, out, 4, n);
+                          }, 4, hop_size, seconds));
+    }
+    
+    // fft size toggled between 1024 and 2048 every 16 hops: the new engines
+    // are built in the background and crossfaded in, so this runs about as
+    // many switches as the background thread keeps up with
+    {
+        GeometrySwitcher<JVFreezer> switcher (2, GeometrySwitcher<JVFreezer>::Geometry {1024, 256, 1024, false});
+        const int hops_per_switch = 16;
+        int hops = 0;
+        print_row("JVFreezer x2 switching", 1024, 256, 1024, 2,
+                  measure([&] (const float *const *in, float *const *out, int n)
+                          {
+                              if (++hops % hops_per_switch == 0)
+                              {
+                                  int n_fft = (hops / hops_per_switch) % 2 ? 2048 : 1024;
+                                  switcher.request_geometry(n_fft, n_fft/4, n_fft);
+                              }
+                              switcher.process(in, out, 2, n);
+                          }, 2, 256, seconds));
+    }
+}
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    KernelsBenchmark.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "../../SpectralFreeze/Source/FastMath/FastMath.h"
+#include "../../SpectralFreeze/Source/VectorOperations2/VectorOperations2.h"
+
+namespace bst = boost::numeric::ublas;
+
+/* fast_math: accuracy against std:: and per-bin throughput of both */
+
+/* wall time per element of kernel() over num_bins elements, repeated */
+static double time_per_bin(std::function<void()> kernel, int num_bins, double seconds)
+{
+    using clock = std::chrono::steady_clock;
+    int repeats = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    while (elapsed < seconds)
+    {
+        for (int r = 0; r < 64; r++)
+            kernel();
+        repeats += 64;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+    return 1e9 * elapsed / (static_cast<double>(repeats) * num_bins);
+}
+
+static double max_error(const std::vector<float> &a, const std::vector<float> &b, bool is_angle)
+{
+    double e = 0.0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        double d = static_cast<double>(a[i]) - b[i];
+        if (is_angle)
+            d = std::remainder(d, 2.0 * M_PI);     // -pi and pi are the same angle
+        e = std::max(e, std::abs(d));
+    }
+    return e;
+}
+
+static void print_fast_math_row(const char *name, double error, double std_ns, double fast_ns)
+{
+    std::printf("%-12s %12.3g %12.2f %12.2f %9.1fx\n", name, error, std_ns, fast_ns, std_ns / fast_ns);
+}
+
+void benchmark_fast_math(double seconds)
+{
+    const int num_bins = 4097;
+    seconds = std::min(seconds, 1.0);
+    
+    juce::Random random (5678);
+    std::vector<float> x (num_bins), y (num_bins), t (num_bins);
+    std::vector<std::complex<float> > z (num_bins), z_std (num_bins), z_fast (num_bins);
+    for (int k = 0; k < num_bins; k++)
+    {
+        x[k] = random.nextFloat() * 20.0f - 10.0f;
+        y[k] = random.nextFloat() * 20.0f - 10.0f;
+        t[k] = random.nextFloat() * 2048.0f - 1024.0f;     // unwrapped phases
+        z[k] = std::complex<float> (x[k], y[k]);
+    }
+    std::vector<float> a_std (num_bins), b_std (num_bins), a_fast (num_bins), b_fast (num_bins);
+    
+    std::printf("\nfast_math (%s), %d bins\n", fast_math::get_instruction_set(), num_bins);
+    std::printf("%-12s %12s %12s %12s %10s\n", "kernel", "max error", "std ns/bin", "fast ns/bin", "speedup");
+    
+    auto std_atan2 = [&] { for (int k = 0; k < num_bins; k++) a_std[k] = std::atan2(y[k], x[k]); };
+    auto fast_atan2 = [&] { fast_math::atan2(y.data(), x.data(), a_fast.data(), num_bins); };
+    std_atan2(); fast_atan2();
+    print_fast_math_row("atan2", max_error(a_std, a_fast, true),
+                        time_per_bin(std_atan2, num_bins, seconds), time_per_bin(fast_atan2, num_bins, seconds));
+    
+    auto std_sincos = [&] { for (int k = 0; k < num_bins; k++) { a_std[k] = std::sin(t[k]); b_std[k] = std::cos(t[k]); } };
+    auto fast_sincos = [&] { fast_math::sincos(t.data(), a_fast.data(), b_fast.data(), num_bins); };
+    std_sincos(); fast_sincos();
+    print_fast_math_row("sincos", std::max(max_error(a_std, a_fast, false), max_error(b_std, b_fast, false)),
+                        time_per_bin(std_sincos, num_bins, seconds), time_per_bin(fast_sincos, num_bins, seconds));
+    
+    auto std_hypot = [&] { for (int k = 0; k < num_bins; k++) a_std[k] = std::hypot(x[k], y[k]); };
+    auto fast_hypot = [&] { fast_math::hypot(x.data(), y.data(), a_fast.data(), num_bins); };
+    std_hypot(); fast_hypot();
+    print_fast_math_row("hypot", max_error(a_std, a_fast, false),
+                        time_per_bin(std_hypot, num_bins, seconds), time_per_bin(fast_hypot, num_bins, seconds));
+    
+    auto std_wrap = [&] { for (int k = 0; k < num_bins; k++)
+                              a_std[k] = t[k] - (2.0 * M_PI * std::floor((t[k] + M_PI) / (2.0 * M_PI))); };
+    auto fast_wrap = [&] { fast_math::wrap_to_pi(t.data(), a_fast.data(), num_bins); };
+    std_wrap(); fast_wrap();
+    print_fast_math_row("wrap_to_pi", max_error(a_std, a_fast, true),
+                        time_per_bin(std_wrap, num_bins, seconds), time_per_bin(fast_wrap, num_bins, seconds));
+    
+    auto std_car2pol = [&] { for (int k = 0; k < num_bins; k++) { a_std[k] = std::abs(z[k]); b_std[k] = std::arg(z[k]); } };
+    auto fast_car2pol = [&] { fast_math::car2pol(z.data(), a_fast.data(), b_fast.data(), num_bins); };
+    std_car2pol(); fast_car2pol();
+    print_fast_math_row("car2pol", std::max(max_error(a_std, a_fast, false), max_error(b_std, b_fast, true)),
+                        time_per_bin(std_car2pol, num_bins, seconds), time_per_bin(fast_car2pol, num_bins, seconds));
+    
+    auto std_pol2car = [&] { for (int k = 0; k < num_bins; k++) z_std[k] = std::polar(a_std[k], b_std[k]); };
+    auto fast_pol2car = [&] { fast_math::pol2car(a_std.data(), b_std.data(), z_fast.data(), num_bins); };
+    std_pol2car(); fast_pol2car();
+    double error = 0.0;
+    for (int k = 0; k < num_bins; k++)
+        error = std::max(error, static_cast<double>(std::abs(z_std[k] - z_fast[k])));
+    print_fast_math_row("pol2car", error,
+                        time_per_bin(std_pol2car, num_bins, seconds), time_per_bin(fast_pol2car, num_bins, seconds));
+}
+
+//==============================================================================
+/* jv_bst: the freezer's per-hop phase difference, written with the returning
+   operations (every result is a new vector) and with caller-owned outputs */
+
+void benchmark_jv_bst(double seconds)
+{
+    const int num_bins = 513;
+    seconds = std::min(seconds, 1.0);
+    
+    juce::Random random (91011);
+    bst::vector<std::complex<float> > current (num_bins), last (num_bins);
+    bst::vector<float> phase_advance (num_bins);
+    for (int k = 0; k < num_bins; k++)
+    {
+        current(k) = std::complex<float> (random.nextFloat() - 0.5f, random.nextFloat() - 0.5f);
+        last(k) = std::complex<float> (random.nextFloat() - 0.5f, random.nextFloat() - 0.5f);
+        phase_advance(k) = M_PI * 0.5f * k;
+    }
+    bst::vector<float> mX (num_bins), current_phase (num_bins), last_phase (num_bins), dp (num_bins);
+    
+    auto returning = [&]
+    {
+        mX = jv_bst::abs(current);
+        current_phase = jv_bst::angle(current);
+        last_phase = jv_bst::angle(last);
+        dp = jv_bst::wrap_to_pi(current_phase - last_phase - phase_advance);
+    };
+    auto caller_owned = [&]
+    {
+        jv_bst::abs(current, mX);
+        jv_bst::angle(current, current_phase);
+        jv_bst::angle(last, last_phase);
+        bst::noalias(dp) = current_phase - last_phase - phase_advance;
+        jv_bst::wrap_to_pi(dp, dp);
+    };
+    auto fused = [&]
+    {
+        jv_bst::noalias(mX) = jv_bst::abs(current);
+        jv_bst::noalias(dp) = jv_bst::wrap_to_pi(jv_bst::angle(current) - jv_bst::angle(last) - phase_advance);
+    };
+    
+    std::printf("\njv_bst phase difference, %d bins\n", num_bins);
+    std::printf("%-14s %12s %12s\n", "form", "allocs/hop", "ns/bin");
+    std::printf("%-14s %12ld %12.2f\n", "returning", count_allocations(returning),
+                time_per_bin(returning, num_bins, seconds));
+    std::printf("%-14s %12ld %12.2f\n", "caller-owned", count_allocations(caller_owned),
+                time_per_bin(caller_owned, num_bins, seconds));
+    std::printf("%-14s %12ld %12.2f\n", "fused", count_allocations(fused),
+                time_per_bin(fused, num_bins, seconds));
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    LatencyBenchmark.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "../../stutterhold/Source/PhaseVocodeur/PhaseVocodeur.h"
+#include "../../SpectralFreeze/Source/GeometrySwitcher/GeometrySwitcher.h"
+#include "../../SpectralFreeze/Source/JVFreezer/JVFreezer.h"
+#include "../../SpectralFreeze/Source/MultiResolutionFreezer/MultiResolutionFreezer.h"
+#include "../../SpectralFreeze/Source/PhaseVocodeur3/PhaseVocodeur3.h"
+
+/* latency: an impulse through process() in blocks that don't line up with
+   the hop, as a host's don't have to */
+
+static void print_latency_row(const char *name, int frame_size, int hop_size, int n_fft,
+                              int reported_latency, int reported_tail,
+                              std::function<void(const float*, float*, int)> process)
+{
+    const int block_size = 100;
+    const int onset = 37;
+    std::vector<float> input (onset + 4 * reported_tail + block_size, 0.0f);
+    std::vector<float> output (input.size(), 0.0f);
+    input[onset] = 1.0f;
+    
+    for (int n = 0; n < static_cast<int>(input.size()); n += block_size)
+    {
+        int num_samples = std::min(block_size, static_cast<int>(input.size()) - n);
+        process(&input[n], &output[n], num_samples);
+    }
+    
+    int peak = 0;
+    for (int n = 0; n < static_cast<int>(output.size()); n++)
+        if (std::fabs(output[n]) > std::fabs(output[peak]))
+            peak = n;
+    int last = peak;
+    for (int n = peak; n < static_cast<int>(output.size()); n++)
+        if (std::fabs(output[n]) > 1.0e-6f * std::fabs(output[peak]))
+            last = n;
+    
+    int measured_latency = peak - onset;
+    int measured_tail = last + 1 - onset;
+    bool ok = measured_latency == reported_latency && measured_tail <= reported_tail;
+    std::printf("%-26s %6d %6d %6d %9d %9d %9d %9d %4s\n", name, frame_size, hop_size, n_fft,
+                reported_latency, measured_latency, reported_tail, measured_tail, ok ? "ok" : "FAIL");
+}
+
+template <class Engine>
+static void print_latency_row(const char *name, Engine &engine)
+{
+    print_latency_row(name, engine.get_frame_size(), engine.get_hop_size(), engine.get_n_fft(),
+                      engine.get_latency_samples(), engine.get_tail_samples(),
+                      [&] (const float *in, float *out, int n) { engine.process(in, out, n); });
+}
+
+void benchmark_latency()
+{
+    std::printf("\nlatency, impulse in blocks of 100 samples\n");
+    std::printf("%-26s %6s %6s %6s %9s %9s %9s %9s\n", "engine", "frame", "hop", "n_fft",
+                "latency", "measured", "tail", "measured");
+    
+    struct Geometry { int frame_size, hop_size, n_fft; };
+    const Geometry geometries[] = {
+        {256,   64,   512},
+        {512,   128,  1024},
+        {1024,  256,  1024},
+        {1024,  256,  2048},
+        {300,   100,  600},
+    };
+    for (auto g : geometries)
+    {
+        PhaseVocodeur pv (g.frame_size, g.hop_size, g.n_fft);
+        print_latency_row("PhaseVocodeur", g.frame_size, g.hop_size, g.n_fft,
+                          pv.get_latency_samples(), pv.get_tail_samples(),
+                          [&] (const float *in, float *out, int n) { pv.process(in, out, n); });
+        PhaseVocodeur3 pv3 (g.frame_size, g.hop_size, g.n_fft);
+        print_latency_row("PhaseVocodeur3", pv3);
+        JVFreezer freezer (g.frame_size, g.hop_size, g.n_fft);
+        print_latency_row("JVFreezer", freezer);
+        
+        PhaseVocodeur3 pv3_low (g.frame_size, g.hop_size, g.n_fft);
+        pv3_low.set_low_latency(true);
+        print_latency_row("PhaseVocodeur3 low latency", pv3_low);
+        JVFreezer freezer_low (g.frame_size, g.hop_size, g.n_fft);
+        freezer_low.set_low_latency(true);
+        print_latency_row("JVFreezer low latency", freezer_low);
+    }
+    
+    // the reported latency follows a switch once the new engines are heard
+    GeometrySwitcher<JVFreezer> switcher (1, GeometrySwitcher<JVFreezer>::Geometry {1024, 256, 1024, false});
+    switcher.request_geometry(2048, 512, 2048);
+    std::vector<float> silence (256, 0.0f);
+    float *block = &silence[0];
+    while (switcher.get_geometry().n_fft != 2048)
+    {
+        switcher.process(&block, &block, 1, 256);
+        if (!switcher.is_switching())
+            std::this_thread::sleep_for(std::chrono::milliseconds (1));
+    }
+    print_latency_row("JVFreezer switched", 2048, 512, 2048,
+                      switcher.get_latency_samples(), switcher.get_tail_samples(),
+                      [&] (const float *in, float *out, int n) { switcher.process(&in, &out, 1, n); });
+    
+    // geometry columns: the full rate band's
+    MultiResolutionFreezer multi_resolution (sample_rate);
+    print_latency_row("MultiResolutionFreezer", 1024, 512, 1024,
+                      multi_resolution.get_latency_samples(), multi_resolution.get_tail_samples(),
+                      [&] (const float *in, float *out, int n) { multi_resolution.process(in, out, n); });
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 4:40:40am
+    Author:  agent
+
+        Headless benchmark for the spectral engines.
+ 
+    Drives PhaseVocodeur (stutterhold), PhaseVocodeur3 and JVFreezer
+    (SpectralFreeze) over a matrix of frame_size / hop_size / n_fft with
+    noise, one hop per block (PhaseVocodeur3 also without its FixedVocodeur
+    where the geometry has one, JVFreezer also in low latency, morphing
+    between two FreezeBank slots and through a GeometrySwitcher changing
+    fft size), and reports for each:
+ 
+        ns/sample       wall time per processed sample (per channel)
+        x realtime      audio time / wall time at 48 kHz
+        mean/worst hop  wall time of one hop_size block
+        allocs/s        operator new calls per second of audio
+ 
+    then checks the fast_math kernels against std:: (max abs error) and
+    times both per bin, counts the vector allocations of the jv_bst
+    phase-difference chain in its returning and caller-owned forms, and
+    times constructing a session's worth of engines, the first of which
+    fills plan_cache and the rest of which share its plans and windows.
+    An impulse through each engine checks the latency and tail it
+    reports to the host against the delay of the output's peak and the
+    last sample above -120 dB of it. Then each analysis window type's
+    reconstruction error, and the allocations of switching between them
+    while running. Last, MultiResolutionFreezer against the single
+    JVFreezers with its low band's resolution: 4096 points at hop 1024,
+    and at its high band's hop of 512, all in blocks of 512.
+ 
+    With --check-allocations it instead runs every audio path, live and
+    frozen, under the operator new count and exits with 1 if any of them
+    allocated.
+ 
+    Each table is a suite in its own file (Suites.h), on the counting and
+    timing of Measure.h.
+ 
+    usage: Benchmark [seconds of audio per run, default 10]
+           Benchmark --check-allocations
+ 
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../SpectralFreeze/Source/RealtimeGuard/RealtimeGuard.h"
+
+#include "Suites.h"
+
+//==============================================================================
+
+int main (int argc, char* argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check-allocations") == 0)
+        return check_allocations() ? 0 : 1;
+    
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 10.0;
+    if (seconds <= 0.0)
+        seconds = 10.0;
+    
+    benchmark_engines(seconds);
+    benchmark_fast_math(seconds);
+    benchmark_jv_bst(seconds);
+    benchmark_construction();
+    benchmark_latency();
+    benchmark_windows();
+    benchmark_multi_resolution(seconds);
+    
+    rt_guard::print_violations();
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    Measure.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <JuceHeader.h>
+
+long count_allocations(std::function<void()> f)
+{
+   #if RT_GUARD
+    long violations = rt_guard::get_violation_count();
+    {
+        RT_GUARD_SCOPE("Benchmark::count_allocations");
+        f();
+    }
+    return rt_guard::get_violation_count() - violations;
+   #else
+    start_counting_allocations();
+    f();
+    return stop_counting_allocations();
+   #endif
+}
+
+Result measure(BlockProcess process, int num_channels, int hop_size, double seconds)
+{
+    int num_samples = static_cast<int>(seconds * sample_rate);
+    num_samples -= num_samples % hop_size;
+    
+    // noise in, one buffer per channel
+    juce::Random random (1234);
+    std::vector<std::vector<float> > input (num_channels, std::vector<float> (num_samples));
+    std::vector<std::vector<float> > output = input;
+    for (auto &channel : input)
+        for (auto &x : channel)
+            x = random.nextFloat() * 2.0f - 1.0f;
+    
+    std::vector<const float*> r (num_channels);
+    std::vector<float*> w (num_channels);
+    
+    // warm up: fill the rings and the caches
+    for (int n = 0; n < 8 * hop_size; n += hop_size)
+    {
+        for (int c = 0; c < num_channels; c++)
+        {
+            r[c] = &input[c][n];
+            w[c] = &output[c][n];
+        }
+        process(r.data(), w.data(), hop_size);
+    }
+    
+    using clock = std::chrono::steady_clock;
+    double worst = 0.0;
+    double total = 0.0;
+    
+   #if RT_GUARD
+    long violations = rt_guard::get_violation_count();
+    RT_GUARD_SCOPE("Benchmark::measure");
+   #else
+    start_counting_allocations();
+   #endif
+    
+    for (int n = 0; n < num_samples; n += hop_size)
+    {
+        for (int c = 0; c < num_channels; c++)
+        {
+            r[c] = &input[c][n];
+            w[c] = &output[c][n];
+        }
+        auto start = clock::now();
+        process(r.data(), w.data(), hop_size);
+        double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        
+        total += elapsed;
+        worst = std::max(worst, elapsed);
+    }
+    
+   #if RT_GUARD
+    long num_allocations = rt_guard::get_violation_count() - violations;
+   #else
+    long num_allocations = stop_counting_allocations();
+   #endif
+    
+    int num_hops = num_samples / hop_size;
+    Result result;
+    result.ns_per_sample        = 1e9 * total / (static_cast<double>(num_samples) * num_channels);
+    result.realtime_factor      = (num_samples / sample_rate) / total;
+    result.mean_hop_us          = 1e6 * total / num_hops;
+    result.worst_hop_us         = 1e6 * worst;
+    result.allocs_per_second    = num_allocations / (num_samples / sample_rate);
+    return result;
+}
+
+void print_header()
+{
+    std::printf("%-28s %6s %5s %6s %3s %10s %11s %11s %11s %10s\n",
+                "engine", "frame", "hop", "n_fft", "ch",
+                "ns/sample", "x realtime", "mean hop us", "worst hop us", "allocs/s");
+}
+
+void print_row(const char *name, int frame_size, int hop_size, int n_fft, int num_channels, Result r)
+{
+    std::printf("%-28s %6d %5d %6d %3d %10.2f %11.1f %11.2f %11.2f %10.1f\n",
+                name, frame_size, hop_size, n_fft, num_channels,
+                r.ns_per_sample, r.realtime_factor, r.mean_hop_us, r.worst_hop_us, r.allocs_per_second);
+}
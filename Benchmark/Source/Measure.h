@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    Measure.h
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+        What the benchmark suites share: counting allocations, timing an
+        engine's blocks, and the rows of the engine tables.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "../../SpectralFreeze/Source/RealtimeGuard/RealtimeGuard.h"
+
+constexpr double sample_rate = 48000.0;
+
+struct Result
+{
+    double ns_per_sample;
+    double realtime_factor;
+    double mean_hop_us;
+    double worst_hop_us;
+    double allocs_per_second;
+};
+
+/* process(input[c], output[c], block) for all channels in one call */
+using BlockProcess = std::function<void(const float *const *input, float *const *output, int num_samples)>;
+
+/* allocations (or guard violations) made by one call of f */
+long count_allocations(std::function<void()> f);
+
+/* noise through process in hop_size blocks for seconds of audio */
+Result measure(BlockProcess process, int num_channels, int hop_size, double seconds);
+
+void print_header();
+void print_row(const char *name, int frame_size, int hop_size, int n_fft, int num_channels, Result r);
+
+#if ! RT_GUARD
+/* AllocationCount.cpp: operator new calls on this thread from start to stop */
+void start_counting_allocations();
+long stop_counting_allocations();
+#endif
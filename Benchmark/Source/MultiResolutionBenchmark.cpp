@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    MultiResolutionBenchmark.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <cstdio>
+
+#include "../../SpectralFreeze/Source/JVFreezer/JVFreezer.h"
+#include "../../SpectralFreeze/Source/MultiResolutionFreezer/MultiResolutionFreezer.h"
+
+/* multi-resolution: a decimated freezer and a full rate one against one big
+   one at the low band's resolution, at its usual hop and at the high
+   band's, all in the same blocks (the hops differ) */
+
+void benchmark_multi_resolution(double seconds)
+{
+    std::printf("\nmulti-resolution, against 4096 points at 48 kHz\n");
+    print_header();
+    const int block_size = 512;
+    
+    for (bool frozen : {false, true})
+    {
+        // geometry columns: the full rate band's
+        MultiResolutionFreezer multi_resolution (sample_rate);
+        multi_resolution.set_is_freeze_active(frozen);
+        print_row(frozen ? "MultiResolution frozen" : "MultiResolution", 1024, 512, 1024, 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { multi_resolution.process(in[0], out[0], n); },
+                          1, block_size, seconds));
+        
+        JVFreezer freezer (4096, 1024, 4096);
+        freezer.set_is_freeze_active(frozen);
+        print_row(frozen ? "JVFreezer frozen" : "JVFreezer", 4096, 1024, 4096, 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { freezer.process(in[0], out[0], n); },
+                          1, block_size, seconds));
+        
+        JVFreezer fine_hop (4096, 512, 4096);
+        fine_hop.set_is_freeze_active(frozen);
+        print_row(frozen ? "JVFreezer frozen" : "JVFreezer", 4096, 512, 4096, 1,
+                  measure([&] (const float *const *in, float *const *out, int n) { fine_hop.process(in[0], out[0], n); },
+                          1, block_size, seconds));
+    }
+}
@@ -0,0 +1,26 @@
+/*
+  ==============================================================================
+
+    Suites.h
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+        The benchmark's tables, one suite each (seconds: of audio per
+        timed run).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+void benchmark_engines(double seconds);             // EnginesBenchmark.cpp
+void benchmark_fast_math(double seconds);           // KernelsBenchmark.cpp
+void benchmark_jv_bst(double seconds);
+void benchmark_construction();                      // ConstructionBenchmark.cpp
+void benchmark_latency();                           // LatencyBenchmark.cpp
+void benchmark_windows();                           // WindowsBenchmark.cpp
+void benchmark_multi_resolution(double seconds);    // MultiResolutionBenchmark.cpp
+
+/* --check-allocations: true unless something allocated on the audio
+   thread */
+bool check_allocations();                           // AllocationCheck.cpp
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    WindowsBenchmark.cpp
+    Created: 17 Oct 2026 9:36:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "Measure.h"
+#include "Suites.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../../SpectralFreeze/Source/JVFreezer/JVFreezer.h"
+#include "../../SpectralFreeze/Source/PhaseVocodeur3/PhaseVocodeur3.h"
+#include "../../SpectralFreeze/Source/PlanCache/PlanCache.h"
+
+/* windows: PhaseVocodeur3 with each analysis window type should give its
+   input back, delayed by its latency; switching types mid-stream swaps
+   tables built at construction and must not allocate */
+
+static double reconstruction_error(plan_cache::WindowType type, int frame_size, int hop_size, int n_fft)
+{
+    PhaseVocodeur3 pv3 (frame_size, hop_size, n_fft);
+    pv3.set_window_type(type);
+    
+    const int len = 16 * n_fft;
+    std::vector<float> input (len), output (len);
+    for (auto &x : input)
+        x = 2.0f * static_cast<float>(std::rand()) / RAND_MAX - 1.0f;
+    pv3.process(&input[0], &output[0], len);
+    
+    // once the first frames have filled up
+    int latency = pv3.get_latency_samples();
+    double error = 0.0;
+    for (int n = 2 * n_fft; n < len; n++)
+        error = std::max(error, static_cast<double>(std::fabs(output[n] - input[n - latency])));
+    return error;
+}
+
+void benchmark_windows()
+{
+    std::printf("\nwindows, max reconstruction error\n");
+    std::printf("%-16s %16s %16s %16s\n", "window", "1024/256/1024", "1000/300/1024", "480/160/512");
+    
+    const char *names[plan_cache::num_analysis_types] = {"hann", "hamming", "blackman-harris", "kaiser", "sqrt-hann"};
+    for (int i = 0; i < plan_cache::num_analysis_types; i++)
+    {
+        auto type = static_cast<plan_cache::WindowType>(i);
+        std::printf("%-16s %16.2e %16.2e %16.2e\n", names[i],
+                    reconstruction_error(type, 1024, 256, 1024),
+                    reconstruction_error(type, 1000, 300, 1024),
+                    reconstruction_error(type, 480, 160, 512));
+    }
+    
+    // a different type every block of a frozen JVFreezer
+    JVFreezer freezer;
+    freezer.set_is_freeze_active(true);
+    std::vector<float> block (freezer.get_hop_size(), 0.0f);
+    long allocations = count_allocations([&]
+    {
+        for (int b = 0; b < 1000; b++)
+        {
+            freezer.set_window_type(static_cast<plan_cache::WindowType>(b % plan_cache::num_analysis_types));
+            freezer.process(&block[0], &block[0], static_cast<int>(block.size()));
+        }
+    });
+    std::printf("switching every block: %ld allocations in 1000 blocks\n", allocations);
+}
@@ -49,10 +49,11 @@ void BarGraph::resized()
 }
 
 
-void BarGraph::set_data(Array<float> new_data)
+void BarGraph::set_data(const Array<float> &new_data)
 {
-    data.clear();
-    data = new_data;
+    // reuse storage
+    data.clearQuick();
+    data.addArray(new_data);
     
     // calc width
     rect_width = getWidth() / (float) data.size();
@@ -71,7 +72,7 @@ void BarGraph::set_colour(Colour new_colour)
 // ==========================================================
 void BarGraph::update_rects()
 {
-    rects.clear();
+    rects.clearQuick();
     
     int i = 0;
     for (float & value : data)
@@ -18,7 +18,7 @@ public:
     void paint (Graphics &g) override;
     void resized() override;
     
-    void set_data(Array<float> new_data);
+    void set_data(const Array<float> &new_data);
     void set_colour(Colour new_colour);
     
 private:
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    BatchFFT.cpp
+    Created: 17 Oct 2026 4:35:43am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "BatchFFT.h"
+
+#if BATCH_FFT_SIMD
+/* from kiss_fft_simd.c: kiss_fftr built with kiss_fft_scalar = __m128 */
+extern "C"
+{
+    struct kiss_fftr_simd_state* kiss_fftr_simd_alloc(int nfft, int inverse_fft, void *mem, size_t *lenmem);
+    void kiss_fftr_simd(struct kiss_fftr_simd_state *cfg, const __m128 *timedata, __m128 *freqdata);
+    void kiss_fftri_simd(struct kiss_fftr_simd_state *cfg, const __m128 *freqdata, __m128 *timedata);
+}
+#endif
+
+BatchFFT::BatchFFT(int n_fft)
+{
+    if (n_fft % 2 != 0)
+        throw std::length_error("n_fft must be even");
+    
+    this->n_fft     = n_fft;
+    this->num_bins  = n_fft/2 + 1;
+    
+#if BATCH_FFT_SIMD
+    forward_plan = kiss_fftr_simd_alloc(n_fft, 0, 0, 0);
+    inverse_plan = kiss_fftr_simd_alloc(n_fft, 1, 0, 0);
+    time_lanes      = aligned_vector<float> (4 * n_fft);
+    spectrum_lanes  = aligned_vector<float> (8 * num_bins);
+#else
+    fft.reset(new RealFFT(n_fft));
+#endif
+}
+
+BatchFFT::~BatchFFT()
+{
+#if BATCH_FFT_SIMD
+    // allocated with _mm_malloc by the SIMD build
+    _mm_free(forward_plan);
+    _mm_free(inverse_plan);
+#endif
+}
+
+void BatchFFT::forward(const float *const *time_in, std::complex<float> *const *spectrum_out, int count)
+{
+    jassert (count <= max_batch);
+    
+#if BATCH_FFT_SIMD
+    // interleave, zero the unused lanes
+    float *t = &time_lanes(0);
+    for (int n = 0; n < n_fft; n++)
+    {
+        for (int lane = 0; lane < max_batch; lane++)
+        {
+            t[4*n + lane] = (lane < count) ? time_in[lane][n] : 0.0f;
+        }
+    }
+    
+    kiss_fftr_simd(forward_plan, reinterpret_cast<const __m128*>(&time_lanes(0)),
+                   reinterpret_cast<__m128*>(&spectrum_lanes(0)));
+    
+    // deinterleave
+    const float *z = &spectrum_lanes(0);
+    for (int k = 0; k < num_bins; k++)
+    {
+        for (int lane = 0; lane < count; lane++)
+        {
+            spectrum_out[lane][k] = std::complex<float>(z[8*k + lane], z[8*k + 4 + lane]);
+        }
+    }
+#else
+    for (int lane = 0; lane < count; lane++)
+    {
+        fft->forward(time_in[lane], spectrum_out[lane]);
+    }
+#endif
+}
+
+void BatchFFT::inverse(const std::complex<float> *const *spectrum_in, float *const *time_out, int count,
+                       const float *const *window)
+{
+    jassert (count <= max_batch);
+    
+#if BATCH_FFT_SIMD
+    // interleave, zero the unused lanes
+    float *z = &spectrum_lanes(0);
+    for (int k = 0; k < num_bins; k++)
+    {
+        for (int lane = 0; lane < max_batch; lane++)
+        {
+            bool used = lane < count;
+            z[8*k + lane]       = used ? spectrum_in[lane][k].real() : 0.0f;
+            z[8*k + 4 + lane]   = used ? spectrum_in[lane][k].imag() : 0.0f;
+        }
+    }
+    
+    kiss_fftri_simd(inverse_plan, reinterpret_cast<const __m128*>(&spectrum_lanes(0)),
+                    reinterpret_cast<__m128*>(&time_lanes(0)));
+    
+    // deinterleave with 1/n_fft and window folded in
+    const float *t = &time_lanes(0);
+    float scale = 1.0f / static_cast<float>(n_fft);
+    for (int lane = 0; lane < count; lane++)
+    {
+        float *w = time_out[lane];
+        const float *win = (window != nullptr) ? window[lane] : nullptr;
+        if (win == nullptr)
+        {
+            for (int n = 0; n < n_fft; n++)
+            {
+                w[n] = t[4*n + lane] * scale;
+            }
+        }
+        else
+        {
+            for (int n = 0; n < n_fft; n++)
+            {
+                w[n] = t[4*n + lane] * scale * win[n];
+            }
+        }
+    }
+#else
+    for (int lane = 0; lane < count; lane++)
+    {
+        const float *win = (window != nullptr) ? window[lane] : nullptr;
+        fft->inverse(spectrum_in[lane], time_out[lane], 1.0f, win);
+    }
+#endif
+}
+
+int BatchFFT::get_n_fft()
+{
+    return n_fft;
+}
+int BatchFFT::get_num_bins()
+{
+    return num_bins;
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    BatchFFT.h
+    Created: 17 Oct 2026 4:35:43am
+    Author:  agent
+
+        Up to four real FFTs of length n_fft in one call.
+ 
+    Frames are interleaved into the __m128 layout of the SIMD kiss_fft
+    build (kiss_fft_simd.c), transformed together, and deinterleaved into
+    the callers' half-spectra. Unused lanes are zero. Without SSE each
+    frame goes through RealFFT instead.
+ 
+        forward:    count x n_fft real  ->  count x num_bins bins
+        inverse:    count x num_bins    ->  count x n_fft real, / n_fft
+                                            (and * window[i], if given)
+ 
+    Like RealFFT, nothing is allocated after construction.
+ 
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <complex>
+#include <memory>
+#include <stdexcept>
+
+#include <JuceHeader.h>
+
+#include "../RealFFT/RealFFT.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+ #define BATCH_FFT_SIMD 1
+ #include <xmmintrin.h>
+#else
+ #define BATCH_FFT_SIMD 0
+#endif
+
+class BatchFFT
+{
+    
+public:
+    static constexpr int max_batch {4};
+    
+    BatchFFT(int n_fft);
+    ~BatchFFT();
+    
+    /* count (<= max_batch) real frames -> count half-spectra */
+    void forward(const float *const *time_in, std::complex<float> *const *spectrum_out, int count);
+    /* count half-spectra -> count real frames, scaled by 1 / n_fft and by
+       window[i] when window and window[i] are not nullptr */
+    void inverse(const std::complex<float> *const *spectrum_in, float *const *time_out, int count,
+                 const float *const *window = nullptr);
+    
+    int get_n_fft();
+    int get_num_bins();
+    
+private:
+    int n_fft;
+    int num_bins;
+    
+#if BATCH_FFT_SIMD
+    struct kiss_fftr_simd_state *forward_plan;
+    struct kiss_fftr_simd_state *inverse_plan;
+    
+    /* interleaved buffers, read by kiss_fft as __m128: four lanes of
+       sample n at 4n, real and imaginary lanes of bin k at 8k and 8k + 4 */
+    aligned_vector<float> time_lanes;           // 4 * n_fft
+    aligned_vector<float> spectrum_lanes;       // 8 * num_bins
+#else
+    std::unique_ptr<RealFFT> fft;
+#endif
+    
+    BatchFFT(const BatchFFT&) = delete;
+    BatchFFT& operator=(const BatchFFT&) = delete;
+};
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    kiss_fft_simd.c
+    Created: 17 Oct 2026 4:35:43am
+    Author:  agent
+
+    Second build of kiss_fft and kiss_fftr with USE_SIMD, where every
+    scalar is an __m128 and one call runs four independent transforms
+    (see kiss_fft/README.simd). The public symbols are renamed with a
+    _simd suffix so this links next to the scalar build.
+ 
+    Compiles to nothing without SSE; BatchFFT then falls back to RealFFT.
+
+  ==============================================================================
+*/
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+
+#define USE_SIMD 1
+
+#define kiss_fft_state              kiss_fft_simd_state
+#define kiss_fft_alloc              kiss_fft_simd_alloc
+#define kiss_fft                    kiss_fft_simd
+#define kiss_fft_stride             kiss_fft_simd_stride
+#define kiss_fft_cleanup            kiss_fft_simd_cleanup
+#define kiss_fft_next_fast_size     kiss_fft_simd_next_fast_size
+
+#define kiss_fftr_state             kiss_fftr_simd_state
+#define kiss_fftr_alloc             kiss_fftr_simd_alloc
+#define kiss_fftr                   kiss_fftr_simd
+#define kiss_fftri                  kiss_fftri_simd
+
+#include "../kiss_fft/kiss_fft.c"
+#include "../kiss_fft/tools/kiss_fftr.c"
+
+#endif
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    FastMath.cpp
+    Created: 17 Oct 2026 4:55:43am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "FastMath.h"
+#include "FastMathKernels.h"
+
+#if FAST_MATH_X86 && defined(_MSC_VER) && ! defined(__clang__)
+ #include <intrin.h>
+ #include <immintrin.h>
+#endif
+
+namespace fast_math
+{
+namespace
+{
+    bool has_avx2()
+    {
+       #if FAST_MATH_X86 && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+       #elif FAST_MATH_X86 && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        bool has_fma = (info[2] & (1 << 12)) != 0;
+        bool has_osxsave = (info[2] & (1 << 27)) != 0;
+        if (!has_fma || !has_osxsave || (_xgetbv(0) & 6) != 6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+       #else
+        return false;
+       #endif
+    }
+    
+    detail::KernelTable select_kernel_table()
+    {
+       #if FAST_MATH_X86
+        if (has_avx2())
+            return detail::get_avx2_kernel_table();
+        return detail::make_kernel_table<detail::Sse2>("SSE2");
+       #else
+        return detail::make_kernel_table<detail::Scalar>("scalar");
+       #endif
+    }
+    
+    /* chosen once at load time, so the audio thread never initializes it */
+    const detail::KernelTable kernels = select_kernel_table();
+}
+
+//============ Dispatch ===========================================================
+/* vector kernels take whole vectors, the scalar ones finish the tail */
+
+void atan2(const float *y, const float *x, float *out, int n)
+{
+    int m = kernels.atan2(y, x, out, n);
+    detail::atan2_array<detail::Scalar>(y + m, x + m, out + m, n - m);
+}
+
+void sincos(const float *t, float *sin_out, float *cos_out, int n)
+{
+    int m = kernels.sincos(t, sin_out, cos_out, n);
+    detail::sincos_array<detail::Scalar>(t + m, sin_out != nullptr ? sin_out + m : nullptr,
+                         cos_out != nullptr ? cos_out + m : nullptr, n - m);
+}
+
+void sin(const float *t, float *out, int n)
+{
+    sincos(t, out, nullptr, n);
+}
+
+void cos(const float *t, float *out, int n)
+{
+    sincos(t, nullptr, out, n);
+}
+
+void hypot(const float *x, const float *y, float *out, int n)
+{
+    int m = kernels.hypot(x, y, out, n);
+    detail::hypot_array<detail::Scalar>(x + m, y + m, out + m, n - m);
+}
+
+void wrap_to_pi(const float *t, float *out, int n)
+{
+    int m = kernels.wrap(t, out, n);
+    detail::wrap_array<detail::Scalar>(t + m, out + m, n - m);
+}
+
+void car2pol(const std::complex<float> *z, float *magnitude, float *phase, int n)
+{
+    int m = kernels.car2pol(z, magnitude, phase, n);
+    detail::car2pol_array<detail::Scalar>(z + m, magnitude != nullptr ? magnitude + m : nullptr,
+                          phase != nullptr ? phase + m : nullptr, n - m);
+}
+
+void pol2car(const float *magnitude, const float *phase, std::complex<float> *z, int n, float gain)
+{
+    int m = kernels.pol2car(magnitude, phase, z, n, gain);
+    detail::pol2car_array<detail::Scalar>(magnitude + m, phase + m, z + m, n - m, gain);
+}
+
+const char* get_instruction_set()
+{
+    return kernels.name;
+}
+}
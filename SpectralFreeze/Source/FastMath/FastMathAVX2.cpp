@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    FastMathAVX2.cpp
+    Created: 17 Oct 2026 4:55:43am
+    Author:  agent
+
+        AVX2 + FMA instantiation of the FastMath kernels. Only this file is
+        compiled for AVX2, and FastMath.cpp only calls into it after
+        checking the CPU.
+ 
+  ==============================================================================
+*/
+
+#define FAST_MATH_AVX2_TU 1
+
+#if defined(__clang__)
+ #pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+ #pragma GCC push_options
+ #pragma GCC target("avx2,fma")
+#endif
+
+#include "FastMathKernels.h"
+
+#if FAST_MATH_X86
+fast_math::detail::KernelTable fast_math::detail::get_avx2_kernel_table()
+{
+    return make_kernel_table<Avx2>("AVX2");
+}
+#endif
+
+#if defined(__clang__)
+ #pragma clang attribute pop
+#elif defined(__GNUC__)
+ #pragma GCC pop_options
+#endif
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    FastMathKernels.h
+    Created: 17 Oct 2026 4:55:43am
+    Author:  agent
+
+        Array loops behind FastMath.h, written once against the lane traits
+        of FastMathLanes.h and instantiated for Scalar, Sse2 and (in
+        FastMathAVX2.cpp) Avx2.
+ 
+    Internal to FastMath.cpp and FastMathAVX2.cpp. Avx2 is in an unnamed
+    namespace, so every instantiation that FastMathAVX2.cpp compiles for
+    AVX2 is local to it and can never be linked into the SSE2 or scalar
+    paths.
+ 
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <complex>
+
+#include "FastMathLanes.h"
+
+#if FAST_MATH_X86 && defined(FAST_MATH_AVX2_TU)
+ #include <immintrin.h>
+#endif
+
+namespace fast_math
+{
+namespace detail
+{
+    /* one entry per public function, for runtime dispatch */
+    struct KernelTable
+    {
+        int (*atan2)(const float*, const float*, float*, int);
+        int (*sincos)(const float*, float*, float*, int);
+        int (*hypot)(const float*, const float*, float*, int);
+        int (*wrap)(const float*, float*, int);
+        int (*car2pol)(const std::complex<float>*, float*, float*, int);
+        int (*pol2car)(const float*, const float*, std::complex<float>*, int, float);
+        const char *name;
+    };
+    
+    /* defined in FastMathAVX2.cpp */
+    KernelTable get_avx2_kernel_table();
+    
+   #if FAST_MATH_X86 && defined(FAST_MATH_AVX2_TU)
+    namespace
+    {
+        struct Avx2
+        {
+            using V = __m256;
+            using I = __m256i;
+            static constexpr int width = 8;
+        
+            static V load(const float *p)           { return _mm256_loadu_ps(p); }
+            static void store(float *p, V a)        { _mm256_storeu_ps(p, a); }
+            static V set1(float a)                  { return _mm256_set1_ps(a); }
+            static V add(V a, V b)                  { return _mm256_add_ps(a, b); }
+            static V sub(V a, V b)                  { return _mm256_sub_ps(a, b); }
+            static V mul(V a, V b)                  { return _mm256_mul_ps(a, b); }
+            static V div(V a, V b)                  { return _mm256_div_ps(a, b); }
+            static V fmadd(V a, V b, V c)           { return _mm256_fmadd_ps(a, b, c); }
+            static V min(V a, V b)                  { return _mm256_min_ps(a, b); }
+            static V max(V a, V b)                  { return _mm256_max_ps(a, b); }
+            static V sqrt(V a)                      { return _mm256_sqrt_ps(a); }
+        
+            static V bit_and(V a, V b)              { return _mm256_and_ps(a, b); }
+            static V bit_xor(V a, V b)              { return _mm256_xor_ps(a, b); }
+            static V bit_andnot(V a, V b)           { return _mm256_andnot_ps(a, b); }
+            static V bit_or(V a, V b)               { return _mm256_or_ps(a, b); }
+            static V lt(V a, V b)                   { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static V gt(V a, V b)                   { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+            static V select(V m, V a, V b)          { return _mm256_blendv_ps(b, a, m); }
+        
+            static I round_to_int(V a)              { return _mm256_cvtps_epi32(a); }
+            static I truncate_to_int(V a)           { return _mm256_cvttps_epi32(a); }
+            static V to_float(I i)                  { return _mm256_cvtepi32_ps(i); }
+            static I int_and(I a, int b)            { return _mm256_and_si256(a, _mm256_set1_epi32(b)); }
+            static I int_add(I a, int b)            { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+            static V int_to_sign(I a)               { return _mm256_castsi256_ps(_mm256_slli_epi32(a, 30)); }
+            static V int_nonzero(I a)               { return _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()),
+                                                                                                  _mm256_set1_epi32(-1))); }
+        
+            static void deinterleave(const float *z, V &re, V &im)
+            {
+                V a = _mm256_loadu_ps(z);
+                V b = _mm256_loadu_ps(z + 8);
+                // shuffles stay within 128-bit lanes, then reorder the 64-bit chunks
+                V r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                V i = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0)));
+                im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(i), _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            static void interleave(float *z, V re, V im)
+            {
+                V lo = _mm256_unpacklo_ps(re, im);
+                V hi = _mm256_unpackhi_ps(re, im);
+                _mm256_storeu_ps(z,     _mm256_permute2f128_ps(lo, hi, 0x20));
+                _mm256_storeu_ps(z + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+            }
+        };
+    }
+   #endif
+    
+    //============ Array loops ====================================================
+    /* each processes the first n - n % S::width elements and returns that count */
+    
+    template <class S>
+    int atan2_array(const float *y, const float *x, float *out, int n)
+    {
+        int m = n - n % S::width;
+        for (int i = 0; i < m; i += S::width)
+            S::store(out + i, atan2_kernel<S>(S::load(y + i), S::load(x + i)));
+        return m;
+    }
+    
+    template <class S>
+    int sincos_array(const float *t, float *sin_out, float *cos_out, int n)
+    {
+        int m = n - n % S::width;
+        for (int i = 0; i < m; i += S::width)
+        {
+            typename S::V s, c;
+            sincos_kernel<S>(S::load(t + i), s, c);
+            if (sin_out != nullptr)
+                S::store(sin_out + i, s);
+            if (cos_out != nullptr)
+                S::store(cos_out + i, c);
+        }
+        return m;
+    }
+    
+    template <class S>
+    int hypot_array(const float *x, const float *y, float *out, int n)
+    {
+        int m = n - n % S::width;
+        for (int i = 0; i < m; i += S::width)
+        {
+            typename S::V a = S::load(x + i), b = S::load(y + i);
+            S::store(out + i, S::sqrt(S::fmadd(a, a, S::mul(b, b))));
+        }
+        return m;
+    }
+    
+    template <class S>
+    int wrap_array(const float *t, float *out, int n)
+    {
+        int m = n - n % S::width;
+        for (int i = 0; i < m; i += S::width)
+            S::store(out + i, wrap_kernel<S>(S::load(t + i)));
+        return m;
+    }
+    
+    template <class S>
+    int car2pol_array(const std::complex<float> *z, float *magnitude, float *phase, int n)
+    {
+        int m = n - n % S::width;
+        const float *zf = reinterpret_cast<const float*>(z);
+        for (int i = 0; i < m; i += S::width)
+        {
+            typename S::V re, im;
+            S::deinterleave(zf + 2*i, re, im);
+            if (magnitude != nullptr)
+                S::store(magnitude + i, S::sqrt(S::fmadd(re, re, S::mul(im, im))));
+            if (phase != nullptr)
+                S::store(phase + i, atan2_kernel<S>(im, re));
+        }
+        return m;
+    }
+    
+    template <class S>
+    int pol2car_array(const float *magnitude, const float *phase, std::complex<float> *z, int n, float gain)
+    {
+        int m = n - n % S::width;
+        float *zf = reinterpret_cast<float*>(z);
+        typename S::V g = S::set1(gain);
+        for (int i = 0; i < m; i += S::width)
+        {
+            typename S::V s, c;
+            sincos_kernel<S>(S::load(phase + i), s, c);
+            typename S::V r = S::mul(S::load(magnitude + i), g);
+            S::interleave(zf + 2*i, S::mul(r, c), S::mul(r, s));
+        }
+        return m;
+    }
+    
+    template <class S>
+    KernelTable make_kernel_table(const char *name)
+    {
+        return { atan2_array<S>, sincos_array<S>, hypot_array<S>, wrap_array<S>,
+                 car2pol_array<S>, pol2car_array<S>, name };
+    }
+}
+}
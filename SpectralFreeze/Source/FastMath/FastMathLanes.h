@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    FastMathLanes.h
+    Created: 17 Oct 2026 5:11:35am
+    Author:  agent
+
+        Lane traits (S::V float vector, S::I int vector) and the polynomial
+        kernels written against them, for code that wants to run the
+        fast_math approximations inside its own loops.
+
+    Everything is in fast_math::detail and inline, so any header may
+    include this. Scalar and Sse2 are the only traits here; the AVX2 ones
+    live in FastMathKernels.h, local to FastMathAVX2.cpp.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define FAST_MATH_X86 1
+ #include <emmintrin.h>
+#else
+ #define FAST_MATH_X86 0
+#endif
+
+namespace fast_math
+{
+namespace detail
+{
+    //============ Traits =========================================================
+    /* Scalar and Sse2 are left out of the AVX2 translation unit, so it can
+       never emit an AVX2 copy of their functions */
+    
+   #if ! defined(FAST_MATH_AVX2_TU)
+    struct Scalar
+    {
+        using V = float;
+        using I = int32_t;
+        static constexpr int width = 1;
+        
+        static V load(const float *p)           { return *p; }
+        static void store(float *p, V a)        { *p = a; }
+        static V set1(float a)                  { return a; }
+        static V add(V a, V b)                  { return a + b; }
+        static V sub(V a, V b)                  { return a - b; }
+        static V mul(V a, V b)                  { return a * b; }
+        static V div(V a, V b)                  { return a / b; }
+        static V fmadd(V a, V b, V c)           { return a * b + c; }
+        static V min(V a, V b)                  { return a < b ? a : b; }
+        static V max(V a, V b)                  { return a > b ? a : b; }
+        static V sqrt(V a)                      { return std::sqrt(a); }
+        
+        static uint32_t bits(V a)               { uint32_t u; std::memcpy(&u, &a, 4); return u; }
+        static V from_bits(uint32_t u)          { V a; std::memcpy(&a, &u, 4); return a; }
+        static V bit_and(V a, V b)              { return from_bits(bits(a) & bits(b)); }
+        static V bit_xor(V a, V b)              { return from_bits(bits(a) ^ bits(b)); }
+        static V bit_andnot(V a, V b)           { return from_bits(~bits(a) & bits(b)); }
+        static V bit_or(V a, V b)               { return from_bits(bits(a) | bits(b)); }
+        static V mask(bool m)                   { return from_bits(m ? 0xffffffffu : 0u); }
+        static V lt(V a, V b)                   { return mask(a < b); }
+        static V gt(V a, V b)                   { return mask(a > b); }
+        static V select(V m, V a, V b)          { return bits(m) ? a : b; }
+        
+        static I round_to_int(V a)              { return static_cast<I>(std::nearbyint(a)); }
+        static I truncate_to_int(V a)           { return static_cast<I>(a); }
+        static V to_float(I i)                  { return static_cast<V>(i); }
+        static I int_and(I a, int b)            { return a & b; }
+        static I int_add(I a, int b)            { return a + b; }
+        static V int_to_sign(I a)               { return from_bits(static_cast<uint32_t>(a) << 30); }   // bit 1 -> sign bit
+        static V int_nonzero(I a)               { return mask(a != 0); }
+        
+        static void deinterleave(const float *z, V &re, V &im)   { re = z[0]; im = z[1]; }
+        static void interleave(float *z, V re, V im)             { z[0] = re; z[1] = im; }
+    };
+   #endif
+    
+   #if FAST_MATH_X86 && ! defined(FAST_MATH_AVX2_TU)
+    struct Sse2
+    {
+        using V = __m128;
+        using I = __m128i;
+        static constexpr int width = 4;
+        
+        static V load(const float *p)           { return _mm_loadu_ps(p); }
+        static void store(float *p, V a)        { _mm_storeu_ps(p, a); }
+        static V set1(float a)                  { return _mm_set1_ps(a); }
+        static V add(V a, V b)                  { return _mm_add_ps(a, b); }
+        static V sub(V a, V b)                  { return _mm_sub_ps(a, b); }
+        static V mul(V a, V b)                  { return _mm_mul_ps(a, b); }
+        static V div(V a, V b)                  { return _mm_div_ps(a, b); }
+        static V fmadd(V a, V b, V c)           { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static V min(V a, V b)                  { return _mm_min_ps(a, b); }
+        static V max(V a, V b)                  { return _mm_max_ps(a, b); }
+        static V sqrt(V a)                      { return _mm_sqrt_ps(a); }
+        
+        static V bit_and(V a, V b)              { return _mm_and_ps(a, b); }
+        static V bit_xor(V a, V b)              { return _mm_xor_ps(a, b); }
+        static V bit_andnot(V a, V b)           { return _mm_andnot_ps(a, b); }
+        static V bit_or(V a, V b)               { return _mm_or_ps(a, b); }
+        static V lt(V a, V b)                   { return _mm_cmplt_ps(a, b); }
+        static V gt(V a, V b)                   { return _mm_cmpgt_ps(a, b); }
+        static V select(V m, V a, V b)          { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+        
+        static I round_to_int(V a)              { return _mm_cvtps_epi32(a); }
+        static I truncate_to_int(V a)           { return _mm_cvttps_epi32(a); }
+        static V to_float(I i)                  { return _mm_cvtepi32_ps(i); }
+        static I int_and(I a, int b)            { return _mm_and_si128(a, _mm_set1_epi32(b)); }
+        static I int_add(I a, int b)            { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+        static V int_to_sign(I a)               { return _mm_castsi128_ps(_mm_slli_epi32(a, 30)); }
+        static V int_nonzero(I a)               { return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()),
+                                                                                        _mm_set1_epi32(-1))); }
+        
+        static void deinterleave(const float *z, V &re, V &im)
+        {
+            V a = _mm_loadu_ps(z);
+            V b = _mm_loadu_ps(z + 4);
+            re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+        static void interleave(float *z, V re, V im)
+        {
+            _mm_storeu_ps(z,     _mm_unpacklo_ps(re, im));
+            _mm_storeu_ps(z + 4, _mm_unpackhi_ps(re, im));
+        }
+    };
+   #endif
+    
+    //============ Kernels ========================================================
+    
+    const float pi          = 3.14159265358979323846f;
+    const float half_pi     = 1.57079632679489661923f;
+    const float quarter_pi  = 0.78539816339744830962f;
+    
+    template <class S>
+    inline typename S::V sign_mask()
+    {
+        return S::set1(-0.0f);
+    }
+    
+    template <class S>
+    inline typename S::V atan2_kernel(typename S::V y, typename S::V x)
+    {
+        using V = typename S::V;
+        V sign = sign_mask<S>();
+        V one = S::set1(1.0f);
+        
+        V ax = S::bit_andnot(sign, x);
+        V ay = S::bit_andnot(sign, y);
+        
+        // a = min / max in [0, 1]; atan2(0, 0) = 0
+        V a = S::div(S::min(ax, ay), S::max(S::max(ax, ay), S::set1(1e-30f)));
+        
+        // atan(a) = pi/4 + atan((a - 1) / (a + 1)) above tan(pi/8)
+        V is_big = S::gt(a, S::set1(0.41421356237f));
+        a = S::select(is_big, S::div(S::sub(a, one), S::add(a, one)), a);
+        V r = S::bit_and(is_big, S::set1(quarter_pi));
+        
+        // minimax atan on [-tan(pi/8), tan(pi/8)] (cephes atanf)
+        V z = S::mul(a, a);
+        V p = S::fmadd(S::set1(8.05374449538e-2f), z, S::set1(-1.38776856032e-1f));
+        p = S::fmadd(p, z, S::set1(1.99777106478e-1f));
+        p = S::fmadd(p, z, S::set1(-3.33329491539e-1f));
+        r = S::add(r, S::fmadd(S::mul(p, z), a, a));
+        
+        // back to the full circle
+        r = S::select(S::gt(ay, ax), S::sub(S::set1(half_pi), r), r);
+        r = S::select(S::lt(x, S::set1(0.0f)), S::sub(S::set1(pi), r), r);
+        return S::bit_or(r, S::bit_and(sign, y));
+    }
+    
+    template <class S>
+    inline void sincos_kernel(typename S::V t, typename S::V &s, typename S::V &c)
+    {
+        using V = typename S::V;
+        using I = typename S::I;
+        
+        // t = k pi/2 + r, |r| <= pi/4, with pi/2 split in three (cephes)
+        I k = S::round_to_int(S::mul(t, S::set1(0.63661977236758134308f)));
+        V kf = S::to_float(k);
+        V r = S::fmadd(kf, S::set1(-1.5703125f), t);
+        r = S::fmadd(kf, S::set1(-4.837512969970703125e-4f), r);
+        r = S::fmadd(kf, S::set1(-7.54978995489188216e-8f), r);
+        
+        V z = S::mul(r, r);
+        
+        V sin_r = S::fmadd(S::set1(-1.9515295891e-4f), z, S::set1(8.3321608736e-3f));
+        sin_r = S::fmadd(sin_r, z, S::set1(-1.6666654611e-1f));
+        sin_r = S::fmadd(S::mul(sin_r, z), r, r);
+        
+        V cos_r = S::fmadd(S::set1(2.443315711809948e-5f), z, S::set1(-1.388731625493765e-3f));
+        cos_r = S::fmadd(cos_r, z, S::set1(4.166664568298827e-2f));
+        cos_r = S::fmadd(S::mul(cos_r, z), z, S::fmadd(S::set1(-0.5f), z, S::set1(1.0f)));
+        
+        // quadrant: odd k swaps sin and cos, bit 1 of k (k + 1 for cos) flips the sign
+        V swap = S::int_nonzero(S::int_and(k, 1));
+        s = S::select(swap, cos_r, sin_r);
+        c = S::select(swap, sin_r, cos_r);
+        s = S::bit_xor(s, S::int_to_sign(S::int_and(k, 2)));
+        c = S::bit_xor(c, S::int_to_sign(S::int_and(S::int_add(k, 1), 2)));
+    }
+    
+    template <class S>
+    inline typename S::V wrap_kernel(typename S::V t)
+    {
+        using V = typename S::V;
+        
+        // t - 2 pi floor((t + pi) / 2 pi), floor from truncation
+        V f = S::mul(S::add(t, S::set1(pi)), S::set1(0.15915494309189533577f));
+        V tf = S::to_float(S::truncate_to_int(f));
+        tf = S::sub(tf, S::bit_and(S::gt(tf, f), S::set1(1.0f)));
+        
+        // 2 pi split in two
+        V w = S::fmadd(tf, S::set1(-6.28125f), t);
+        w = S::fmadd(tf, S::set1(-1.9353071795864769253e-3f), w);
+        
+        // f is rounded for large |t|: move results just outside back in
+        V two_pi = S::set1(6.28318530717958647692f);
+        w = S::add(w, S::bit_and(S::lt(w, S::set1(-pi)), two_pi));
+        return S::sub(w, S::bit_and(S::gt(w, S::set1(pi)), two_pi));
+    }
+}
+}
@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+    FixedRealFFT.h
+    Created: 17 Oct 2026 5:22:50am
+    Author:  agent
+
+        Real FFT with its length as a template parameter.
+
+    The n_fft real samples are packed into n_fft/2 complex points (even
+    samples real, odd samples imaginary), transformed by a radix-2 FFT and
+    separated into num_bins = n_fft/2 + 1 bins, as kiss_fftr does. The
+    complex points are kept as separate real and imaginary arrays, so each
+    butterfly stage runs a SIMD width of butterflies at a time (fast_math
+    lanes: SSE2, or scalar elsewhere).
+
+    Twiddles, the bit reversal and the split factors are constexpr tables,
+    computed by the compiler, and every loop bound is a constant:
+
+        forward:    n_fft real samples  ->  num_bins bins (unscaled)
+        inverse:    num_bins bins       ->  n_fft real samples, * scale
+                                            (and * window, if given)
+
+    As with kiss_fftri, the imaginary parts of the DC and Nyquist bins are
+    ignored by inverse. Nothing is allocated: the workspace is two member
+    arrays.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <complex>
+#include <type_traits>
+
+#include "../FastMath/FastMathLanes.h"
+
+namespace fixed_math
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    /* sin(2 pi k / n), for compile-time tables: exact octant reduction on
+       k / n, then a Taylor series on [-pi/2, pi/2] */
+    constexpr double sin_turn(long k, long n)
+    {
+        k %= n;
+        if (k < 0)
+            k += n;
+        if (2*k >= n)
+            k -= n;
+
+        double x = 2.0 * pi * static_cast<double>(k) / static_cast<double>(n);
+        if (x > 0.5 * pi)
+            x = pi - x;
+        else if (x < -0.5 * pi)
+            x = -pi - x;
+
+        double term = x;
+        double sum = x;
+        for (int i = 1; i < 14; i++)
+        {
+            term *= -x * x / static_cast<double>((2*i) * (2*i + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    /* cos(2 pi k / n) = sin(2 pi (4k + n) / 4n) */
+    constexpr double cos_turn(long k, long n)
+    {
+        return sin_turn(4*k + n, 4*n);
+    }
+}
+
+template <int NFFT>
+struct FixedRealFFTTables
+{
+    static constexpr int num_points = NFFT / 2;
+
+    /* twiddles of the stage with half-size h at [h, 2h): exp(-2 pi i j / 2h) */
+    float twiddle_re[num_points];
+    float twiddle_im[num_points];
+    /* split factors: exp(-2 pi i k / n_fft) */
+    float split_re[num_points + 1];
+    float split_im[num_points + 1];
+    /* bit reversal of the point index */
+    int reversed[num_points];
+
+    constexpr FixedRealFFTTables()
+    : twiddle_re(), twiddle_im(), split_re(), split_im(), reversed()
+    {
+        for (int h = 1; h < num_points; h *= 2)
+        {
+            for (int j = 0; j < h; j++)
+            {
+                twiddle_re[h + j] = static_cast<float>(fixed_math::cos_turn(j, 2*h));
+                twiddle_im[h + j] = static_cast<float>(-fixed_math::sin_turn(j, 2*h));
+            }
+        }
+        for (int k = 0; k <= num_points; k++)
+        {
+            split_re[k] = static_cast<float>(fixed_math::cos_turn(k, NFFT));
+            split_im[k] = static_cast<float>(-fixed_math::sin_turn(k, NFFT));
+        }
+
+        int bits = 0;
+        while ((1 << bits) < num_points)
+            bits++;
+        for (int i = 0; i < num_points; i++)
+        {
+            int r = 0;
+            for (int b = 0; b < bits; b++)
+            {
+                if (i & (1 << b))
+                    r |= 1 << (bits - 1 - b);
+            }
+            reversed[i] = r;
+        }
+    }
+};
+
+template <int NFFT>
+class FixedRealFFT
+{
+    static_assert(NFFT >= 16 && (NFFT & (NFFT - 1)) == 0, "n_fft must be a power of 2, at least 16");
+
+public:
+    static constexpr int n_fft = NFFT;
+    static constexpr int num_bins = NFFT/2 + 1;
+
+    /* n_fft real samples -> num_bins complex bins */
+    void forward(const float *time_in, std::complex<float> *spectrum_out)
+    {
+        const Tables &t = tables;
+
+        // pack z[n] = x[2n] + i x[2n+1], in bit-reversed order
+        for (int i = 0; i < num_points; i++)
+        {
+            re[i] = time_in[2 * t.reversed[i]];
+            im[i] = time_in[2 * t.reversed[i] + 1];
+        }
+
+        butterflies<-1>();
+
+        /* separate: X[k] = E[k] + exp(-2 pi i k / n_fft) O[k], where
+           E[k] = (Z[k] + conj(Z[M-k])) / 2 and O[k] = (Z[k] - conj(Z[M-k])) / 2i */
+        float *y = reinterpret_cast<float*>(spectrum_out);
+        y[0] = re[0] + im[0];
+        y[1] = 0.0f;
+        y[2*num_points] = re[0] - im[0];
+        y[2*num_points + 1] = 0.0f;
+        for (int k = 1; k < num_points; k++)
+        {
+            float even_re = 0.5f * (re[k] + re[num_points - k]);
+            float even_im = 0.5f * (im[k] - im[num_points - k]);
+            float odd_re  = 0.5f * (im[k] + im[num_points - k]);
+            float odd_im  = 0.5f * (re[num_points - k] - re[k]);
+            y[2*k]     = even_re + t.split_re[k] * odd_re - t.split_im[k] * odd_im;
+            y[2*k + 1] = even_im + t.split_re[k] * odd_im + t.split_im[k] * odd_re;
+        }
+    }
+
+    /* num_bins complex bins -> n_fft real samples, scaled by scale (1 / n_fft
+       for a true inverse) and optionally by a window in the same pass */
+    void inverse(const std::complex<float> *spectrum_in, float *time_out, float scale, const float *window = nullptr)
+    {
+        const Tables &t = tables;
+        const float *y = reinterpret_cast<const float*>(spectrum_in);
+
+        /* combine: Z[k] = E[k] + i O[k], where E[k] = X[k] + conj(X[M-k]) and
+           O[k] = (X[k] - conj(X[M-k])) exp(2 pi i k / n_fft), in bit-reversed order */
+        re[0] = y[0] + y[2*num_points];
+        im[0] = y[0] - y[2*num_points];
+        for (int k = 1; k < num_points; k++)
+        {
+            int m = num_points - k;
+            float even_re = y[2*k] + y[2*m];
+            float even_im = y[2*k + 1] - y[2*m + 1];
+            float diff_re = y[2*k] - y[2*m];
+            float diff_im = y[2*k + 1] + y[2*m + 1];
+            float odd_re = diff_re * t.split_re[k] + diff_im * t.split_im[k];
+            float odd_im = diff_im * t.split_re[k] - diff_re * t.split_im[k];
+            re[t.reversed[k]] = even_re - odd_im;
+            im[t.reversed[k]] = even_im + odd_re;
+        }
+
+        butterflies<+1>();
+
+        // unpack x[2n] = Re z[n], x[2n+1] = Im z[n]
+        if (window == nullptr)
+        {
+            for (int n = 0; n < num_points; n++)
+            {
+                time_out[2*n]     = re[n] * scale;
+                time_out[2*n + 1] = im[n] * scale;
+            }
+        }
+        else
+        {
+            for (int n = 0; n < num_points; n++)
+            {
+                time_out[2*n]     = re[n] * scale * window[2*n];
+                time_out[2*n + 1] = im[n] * scale * window[2*n + 1];
+            }
+        }
+    }
+
+private:
+    static constexpr int num_points = NFFT / 2;
+
+    typedef FixedRealFFTTables<NFFT> Tables;
+    static constexpr Tables tables {};
+
+#if FAST_MATH_X86
+    typedef fast_math::detail::Sse2 Lanes;
+#else
+    typedef fast_math::detail::Scalar Lanes;
+#endif
+
+    /* complex points, split into real and imaginary parts */
+    alignas(16) std::array<float, num_points> re;
+    alignas(16) std::array<float, num_points> im;
+
+    /* radix-2 decimation in time over bit-reversed points; Sign is the sign
+       of the twiddle exponent (-1 forward, +1 inverse) */
+    template <int Sign>
+    void butterflies()
+    {
+        first_stages<Sign>();
+        stages<Sign, 4>(std::integral_constant<bool, (4 < num_points)>());
+    }
+
+    /* the first two stages as one radix-4 pass: twiddles 1 and -+i */
+    template <int Sign>
+    void first_stages()
+    {
+        for (int b = 0; b < num_points; b += 4)
+        {
+            float a0_re = re[b] + re[b+1],      a0_im = im[b] + im[b+1];
+            float a1_re = re[b] - re[b+1],      a1_im = im[b] - im[b+1];
+            float a2_re = re[b+2] + re[b+3],    a2_im = im[b+2] + im[b+3];
+            float a3_re = re[b+2] - re[b+3],    a3_im = im[b+2] - im[b+3];
+
+            // a3 * exp(Sign i pi / 2)
+            float b3_re = (Sign < 0) ? a3_im : -a3_im;
+            float b3_im = (Sign < 0) ? -a3_re : a3_re;
+
+            re[b]   = a0_re + a2_re;    im[b]   = a0_im + a2_im;
+            re[b+2] = a0_re - a2_re;    im[b+2] = a0_im - a2_im;
+            re[b+1] = a1_re + b3_re;    im[b+1] = a1_im + b3_im;
+            re[b+3] = a1_re - b3_re;    im[b+3] = a1_im - b3_im;
+        }
+    }
+
+    /* stages of half-size H, 2H, ... below num_points, unrolled at compile time */
+    template <int Sign, int H>
+    void stages(std::true_type)
+    {
+        stage<Sign, H>();
+        stages<Sign, 2*H>(std::integral_constant<bool, (2*H < num_points)>());
+    }
+    template <int Sign, int H>
+    void stages(std::false_type)
+    {
+    }
+
+    template <int Sign, int H>
+    void stage()
+    {
+        typedef typename Lanes::V V;
+        const float *w_re = tables.twiddle_re + H;
+        const float *w_im = tables.twiddle_im + H;
+
+        for (int b = 0; b < num_points; b += 2*H)
+        {
+            float *u_re = &re[b];
+            float *u_im = &im[b];
+            float *v_re = &re[b + H];
+            float *v_im = &im[b + H];
+
+            for (int j = 0; j < H; j += Lanes::width)
+            {
+                // t = v * w, w conjugated for the inverse
+                V wr = Lanes::load(w_re + j);
+                V wi = Lanes::load(w_im + j);
+                if (Sign > 0)
+                    wi = Lanes::sub(Lanes::set1(0.0f), wi);
+                V vr = Lanes::load(v_re + j);
+                V vi = Lanes::load(v_im + j);
+                V tr = Lanes::sub(Lanes::mul(vr, wr), Lanes::mul(vi, wi));
+                V ti = Lanes::add(Lanes::mul(vr, wi), Lanes::mul(vi, wr));
+
+                V ur = Lanes::load(u_re + j);
+                V ui = Lanes::load(u_im + j);
+                Lanes::store(v_re + j, Lanes::sub(ur, tr));
+                Lanes::store(v_im + j, Lanes::sub(ui, ti));
+                Lanes::store(u_re + j, Lanes::add(ur, tr));
+                Lanes::store(u_im + j, Lanes::add(ui, ti));
+            }
+        }
+    }
+};
+
+template <int NFFT>
+constexpr FixedRealFFTTables<NFFT> FixedRealFFT<NFFT>::tables;
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    FixedVocodeur.cpp
+    Created: 17 Oct 2026 5:22:50am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "FixedVocodeur.h"
+
+/* presets: frame_size n_fft or n_fft / 2, hop_size frame_size / 4, and
+   frame_size n_fft, hop_size n_fft / 2 up to 1024 */
+template class FixedVocodeur<256,  64,   256>;
+template class FixedVocodeur<128,  32,   256>;
+template class FixedVocodeur<256,  128,  256>;
+template class FixedVocodeur<512,  128,  512>;
+template class FixedVocodeur<256,  64,   512>;
+template class FixedVocodeur<512,  256,  512>;
+template class FixedVocodeur<1024, 256,  1024>;
+template class FixedVocodeur<1024, 512,  1024>;
+template class FixedVocodeur<512,  128,  1024>;
+template class FixedVocodeur<2048, 512,  2048>;
+template class FixedVocodeur<1024, 256,  2048>;
+template class FixedVocodeur<4096, 1024, 4096>;
+template class FixedVocodeur<2048, 512,  4096>;
+
+namespace
+{
+    template <int NFFT>
+    std::unique_ptr<FixedVocodeurBase> make_for_n_fft(int frame_size, int hop_size)
+    {
+        if (frame_size == NFFT && hop_size == NFFT/4)
+            return std::unique_ptr<FixedVocodeurBase> (new FixedVocodeur<NFFT, NFFT/4, NFFT>());
+        if (frame_size == NFFT/2 && hop_size == NFFT/8)
+            return std::unique_ptr<FixedVocodeurBase> (new FixedVocodeur<NFFT/2, NFFT/8, NFFT>());
+        return nullptr;
+    }
+
+    /* sizes with a half overlap preset too */
+    template <int NFFT>
+    std::unique_ptr<FixedVocodeurBase> make_for_small_n_fft(int frame_size, int hop_size)
+    {
+        if (frame_size == NFFT && hop_size == NFFT/2)
+            return std::unique_ptr<FixedVocodeurBase> (new FixedVocodeur<NFFT, NFFT/2, NFFT>());
+        return make_for_n_fft<NFFT>(frame_size, hop_size);
+    }
+}
+
+std::unique_ptr<FixedVocodeurBase> make_fixed_vocodeur(int frame_size, int hop_size, int n_fft, int ola_size)
+{
+    if (ola_size != n_fft)
+        return nullptr;
+
+    switch (n_fft)
+    {
+        case 256:   return make_for_small_n_fft<256>(frame_size, hop_size);
+        case 512:   return make_for_small_n_fft<512>(frame_size, hop_size);
+        case 1024:  return make_for_small_n_fft<1024>(frame_size, hop_size);
+        case 2048:  return make_for_n_fft<2048>(frame_size, hop_size);
+        case 4096:  return make_for_n_fft<4096>(frame_size, hop_size);
+        default:    return nullptr;
+    }
+}
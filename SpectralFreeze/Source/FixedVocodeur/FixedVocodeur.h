@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    FixedVocodeur.h
+    Created: 17 Oct 2026 5:22:50am
+    Author:  agent
+
+        PhaseVocodeur3's per-hop loops with the geometry fixed at compile time.
+
+    FixedVocodeur<FrameSize, HopSize, NFFT> gathers and windows a frame from
+    the input history ring, runs a FixedRealFFT each way and overlap-adds
+    into the output accumulator ring. Every loop bound is a template
+    parameter, the Hann window and its overlap-add normalization are
+    constexpr tables and the fft twiddles are constexpr too, so the
+    compiler can unroll and vectorize all of it.
+
+    The rings and their positions stay in PhaseVocodeur3, which calls the
+    kernels through FixedVocodeurBase once per hop. make_fixed_vocodeur
+    picks the instantiation for a geometry when the engine is prepared:
+
+        n_fft       256, 512, 1024, 2048, 4096
+        frame_size  n_fft or n_fft / 2
+        hop_size    frame_size / 4
+        ola_size    n_fft
+
+    and, for 256 to 1024, frame_size n_fft with hop_size n_fft / 2 (the
+    bands of MultiResolutionFreezer).
+
+    Other geometries get nullptr, and PhaseVocodeur3 keeps its runtime
+    loops and RealFFT.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <boost/align/aligned_alloc.hpp>
+
+#include "FixedRealFFT.h"
+
+class FixedVocodeurBase
+{
+
+public:
+    virtual ~FixedVocodeurBase() {}
+
+    /* w = hann window * the last ola_size samples of the history ring,
+       oldest first (history_pos is the oldest) */
+    virtual void gather_frame(const float *history, int history_pos, float *w) = 0;
+    /* frame * synthesis window (overlap-add normalization) into the
+       accumulator ring from start */
+    virtual void overlap_add(float *accumulator, int start, const float *frame) = 0;
+
+    /* n_fft real samples -> num_bins bins */
+    virtual void forward(const float *time_in, std::complex<float> *spectrum_out) = 0;
+    /* num_bins bins -> n_fft real samples, / n_fft and * window, if given */
+    virtual void inverse(const std::complex<float> *spectrum_in, float *time_out, const float *window) = 0;
+
+    /* fft workspace is aligned for the SIMD stages */
+    static void* operator new(std::size_t size)
+    {
+        void *p = boost::alignment::aligned_alloc(64, size);
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return p;
+    }
+    static void operator delete(void *p)
+    {
+        boost::alignment::aligned_free(p);
+    }
+};
+
+/* Hann window of length len, zero-padded to size */
+template <int Len, int Size>
+struct FixedHannWindow
+{
+    float w[Size];
+
+    constexpr FixedHannWindow()
+    : w()
+    {
+        for (int n = 0; n < Len; n++)
+        {
+            // sin(pi n / len)^2, as hann()
+            double s = fixed_math::sin_turn(n, 2*Len);
+            w[n] = static_cast<float>(s * s);
+        }
+    }
+};
+
+/* 1 / what Hann windows of length len, zero-padded to size, sum to at each
+   sample when overlap-added every hop samples, as cola_normalize() */
+template <int Len, int Size, int Hop>
+struct FixedSynthesisWindow
+{
+    float w[Size];
+
+    constexpr FixedSynthesisWindow()
+    : w()
+    {
+        const FixedHannWindow<Len, Size> hann {};
+        for (int r = 0; r < Hop && r < Size; r++)
+        {
+            double sum = 0.0;
+            for (int n = r; n < Size; n += Hop)
+                sum += hann.w[n];
+            for (int n = r; n < Size; n += Hop)
+                w[n] = (sum > 0.0) ? static_cast<float>(1.0 / sum) : 0.0f;
+        }
+    }
+};
+
+template <int FrameSize, int HopSize, int NFFT>
+class FixedVocodeur : public FixedVocodeurBase
+{
+    static_assert(FrameSize <= NFFT, "frame_size must fit in n_fft");
+    static_assert(HopSize > 0 && HopSize <= FrameSize, "hop_size must be in (0, frame_size]");
+
+public:
+    static constexpr int frame_size  = FrameSize;
+    static constexpr int hop_size    = HopSize;
+    static constexpr int n_fft       = NFFT;
+    static constexpr int ola_size    = NFFT;
+    static constexpr int acc_size    = NFFT + HopSize;
+
+    void gather_frame(const float *history, int history_pos, float *w) override
+    {
+        const float *h = window.w;
+        int first = ola_size - history_pos;     // samples before the ring wraps
+
+        if (first >= FrameSize)
+        {
+            for (int n = 0; n < FrameSize; n++)
+                w[n] = history[history_pos + n] * h[n];
+        }
+        else
+        {
+            for (int n = 0; n < first; n++)
+                w[n] = history[history_pos + n] * h[n];
+            for (int n = first; n < FrameSize; n++)
+                w[n] = history[n - first] * h[n];
+        }
+
+        // zero padding
+        for (int n = FrameSize; n < ola_size; n++)
+            w[n] = 0.0f;
+    }
+
+    void overlap_add(float *accumulator, int start, const float *frame) override
+    {
+        const float *sw = synthesis_window.w;
+        int first = acc_size - start;           // samples before the ring wraps
+
+        if (first >= ola_size)
+        {
+            for (int n = 0; n < ola_size; n++)
+                accumulator[start + n] += frame[n] * sw[n];
+        }
+        else
+        {
+            for (int n = 0; n < first; n++)
+                accumulator[start + n] += frame[n] * sw[n];
+            for (int n = first; n < ola_size; n++)
+                accumulator[n - first] += frame[n] * sw[n];
+        }
+    }
+
+    void forward(const float *time_in, std::complex<float> *spectrum_out) override
+    {
+        fft.forward(time_in, spectrum_out);
+    }
+
+    void inverse(const std::complex<float> *spectrum_in, float *time_out, const float *window) override
+    {
+        fft.inverse(spectrum_in, time_out, 1.0f / static_cast<float>(NFFT), window);
+    }
+
+private:
+    typedef FixedHannWindow<FrameSize, NFFT> Window;
+    static constexpr Window window {};
+
+    /* overlap-add normalization, as plan_cache::OverlapAddWindows::synthesis */
+    typedef FixedSynthesisWindow<FrameSize, NFFT, HopSize> SynthesisWindow;
+    static constexpr SynthesisWindow synthesis_window {};
+
+    FixedRealFFT<NFFT> fft;
+};
+
+template <int FrameSize, int HopSize, int NFFT>
+constexpr FixedHannWindow<FrameSize, NFFT> FixedVocodeur<FrameSize, HopSize, NFFT>::window;
+
+template <int FrameSize, int HopSize, int NFFT>
+constexpr FixedSynthesisWindow<FrameSize, NFFT, HopSize> FixedVocodeur<FrameSize, HopSize, NFFT>::synthesis_window;
+
+/* the instantiation for this geometry, or nullptr if it isn't a preset */
+std::unique_ptr<FixedVocodeurBase> make_fixed_vocodeur(int frame_size, int hop_size, int n_fft, int ola_size);
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    FreezeBank.cpp
+    Created: 17 Oct 2026 7:05:59am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "FreezeBank.h"
+
+#include <algorithm>
+
+FreezeBank::FreezeBank(int num_slots, int num_channels, int capacity)
+: num_slots(num_slots), num_channels(num_channels), capacity(capacity)
+{
+    magnitudes = bst::vector<std::uint16_t> (num_slots * num_channels * capacity, 0);
+    increments = bst::vector<std::int16_t> (num_slots * num_channels * capacity, 0);
+    captures = std::vector<Capture> (num_slots * num_channels);
+}
+
+void FreezeBank::store(int slot, int channel, const float *magnitude, const float *increment,
+                       int num_bins, int hop_size)
+{
+    /* runs on the audio thread: only touches preallocated containers */
+    if (slot < 0 || slot >= num_slots || channel < 0 || channel >= num_channels)
+        return;
+    num_bins = std::min(num_bins, capacity);
+
+    std::uint16_t *m = &magnitudes(index(slot, channel) * capacity);
+    std::int16_t *p = &increments(index(slot, channel) * capacity);
+    for (int k = 0; k < num_bins; k++)
+    {
+        m[k] = float_to_half(magnitude[k]);
+
+        p[k] = increment_to_units(increment[k]);
+    }
+
+    captures[index(slot, channel)].num_bins = num_bins;
+    captures[index(slot, channel)].hop_size = hop_size;
+}
+
+bool FreezeBank::matches(int slot, int channel, int num_bins, int hop_size)
+{
+    if (slot < 0 || slot >= num_slots || channel < 0 || channel >= num_channels)
+        return false;
+    const Capture &capture = captures[index(slot, channel)];
+    return capture.num_bins == num_bins && capture.hop_size == hop_size;
+}
+
+const std::uint16_t* FreezeBank::get_magnitudes(int slot, int channel)
+{
+    return &magnitudes(index(slot, channel) * capacity);
+}
+const std::int16_t* FreezeBank::get_increments(int slot, int channel)
+{
+    return &increments(index(slot, channel) * capacity);
+}
+
+int FreezeBank::get_num_slots()
+{
+    return num_slots;
+}
+int FreezeBank::get_num_channels()
+{
+    return num_channels;
+}
+int FreezeBank::get_capacity()
+{
+    return capacity;
+}
+
+int FreezeBank::index(int slot, int channel)
+{
+    return slot * num_channels + channel;
+}
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    FreezeBank.h
+    Created: 17 Oct 2026 7:05:59am
+    Author:  agent
+
+        Bank of captured freezes for JVFreezer to recall and morph between.
+
+    Each slot holds, per channel, the half-spectrum a freezer would hold:
+    magnitudes as float16 and per-bin phase increments (radians per hop)
+    as 16 bit fractions of a turn, 4 bytes a bin against the 16 of
+    JVFreezer's current/last complex pair. The increment's wrap around is
+    the integer's, so the difference of two increments taken in 16 bits
+    is already the shortest way round.
+
+    Everything is allocated at construction (prepareToPlay); store and the
+    getters only index into it, so capturing and recalling are constant
+    time on the audio thread. A capture remembers its geometry, and only
+    plays on freezers with the same bins and hop.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+namespace bst = boost::numeric::ublas;
+
+class FreezeBank
+{
+
+public:
+    FreezeBank(int num_slots, int num_channels, int capacity);
+
+    /* audio thread: magnitude and increment (radians per hop) over
+       num_bins <= capacity into slot */
+    void store(int slot, int channel, const float *magnitude, const float *increment,
+               int num_bins, int hop_size);
+
+    /* whether slot holds a capture of channel for this geometry */
+    bool matches(int slot, int channel, int num_bins, int hop_size);
+
+    const std::uint16_t* get_magnitudes(int slot, int channel);
+    const std::int16_t* get_increments(int slot, int channel);
+
+    int get_num_slots();
+    int get_num_channels();
+    int get_capacity();
+
+    /* radians per unit of a stored increment */
+    static constexpr float increment_scale {static_cast<float>(2.0 * M_PI / 65536.0)};
+
+    /* radians per hop to the stored units, wrapped to [-32768, 32768),
+       half a turn each way */
+    static inline std::int16_t increment_to_units(float increment)
+    {
+        long units = std::lround(increment / increment_scale);
+        units = ((units + 32768) & 0xffff) - 32768;
+        return static_cast<std::int16_t>(units);
+    }
+
+    /* IEEE half precision, rounded to nearest even */
+    static inline std::uint16_t float_to_half(float f)
+    {
+        std::uint32_t x;
+        std::memcpy(&x, &f, sizeof(x));
+        std::uint32_t sign = (x >> 16) & 0x8000u;
+        x &= 0x7fffffffu;
+
+        std::uint32_t h;
+        if (x >= 0x47800000u)
+        {
+            // past the largest half: infinity, or nan
+            h = (x > 0x7f800000u) ? 0x7e00u : 0x7c00u;
+        }
+        else if (x < 0x38800000u)
+        {
+            // subnormal: adding 0.5 rounds the mantissa into the low bits
+            float v;
+            std::memcpy(&v, &x, sizeof(v));
+            v += 0.5f;
+            std::memcpy(&x, &v, sizeof(x));
+            h = x - 0x3f000000u;
+        }
+        else
+        {
+            // rebias the exponent and round off 13 mantissa bits
+            std::uint32_t odd = (x >> 13) & 1u;
+            x += 0xc8000fffu + odd;
+            h = x >> 13;
+        }
+        return static_cast<std::uint16_t>(h | sign);
+    }
+    static inline float half_to_float(std::uint16_t h)
+    {
+        std::uint32_t x = static_cast<std::uint32_t>(h & 0x7fffu) << 13;
+        std::uint32_t exponent = x & 0x0f800000u;
+        x += 0x38000000u;
+
+        float f;
+        if (exponent == 0x0f800000u)
+        {
+            // infinity, or nan
+            x += 0x38000000u;
+            std::memcpy(&f, &x, sizeof(f));
+        }
+        else if (exponent == 0)
+        {
+            // zero or subnormal
+            x += 0x00800000u;
+            std::memcpy(&f, &x, sizeof(f));
+            f -= 6.103515625e-05f;
+        }
+        else
+        {
+            std::memcpy(&f, &x, sizeof(f));
+        }
+        return (h & 0x8000u) ? -f : f;
+    }
+
+private:
+    int num_slots;
+    int num_channels;
+    int capacity;
+
+    /* slot-major, then channel, capacity bins each */
+    bst::vector<std::uint16_t> magnitudes;
+    bst::vector<std::int16_t> increments;
+
+    /* geometry of each capture (num_bins 0: empty) */
+    struct Capture
+    {
+        int num_bins {0};
+        int hop_size {0};
+    };
+    std::vector<Capture> captures;
+
+    int index(int slot, int channel);
+
+    FreezeBank(const FreezeBank&) = delete;
+    FreezeBank& operator=(const FreezeBank&) = delete;
+};
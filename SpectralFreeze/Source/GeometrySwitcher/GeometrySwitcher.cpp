@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    GeometrySwitcher.cpp
+    Created: 17 Oct 2026 7:32:55am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "GeometrySwitcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geometry_worker
+{
+    namespace
+    {
+        struct Worker
+        {
+            /* add and remove, one at a time, so starting and joining the
+               thread never overlap */
+            std::mutex lifecycle;
+
+            /* tasks, stopping and running. Not held while a task runs (a
+               build takes a while): remove waits on finished until its
+               own task isn't the one running */
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable finished;
+            std::vector<Task*> tasks;
+            Task *running {nullptr};
+            bool stopping {false};
+
+            std::thread thread;
+        };
+
+        /* function-local, so it is built before any switcher registers */
+        Worker& worker()
+        {
+            static Worker w;
+            return w;
+        }
+
+        void run()
+        {
+            Worker &w = worker();
+            std::vector<Task*> pass;
+            std::unique_lock<std::mutex> lock (w.mutex);
+            while (!w.stopping)
+            {
+                // tasks can be added and removed while one runs
+                pass = w.tasks;
+                for (Task *task : pass)
+                {
+                    if (std::find(w.tasks.begin(), w.tasks.end(), task) == w.tasks.end())
+                        continue;
+                    
+                    w.running = task;
+                    lock.unlock();
+                    task->run();
+                    lock.lock();
+                    w.running = nullptr;
+                    w.finished.notify_all();
+                }
+                w.wake.wait_for(lock, std::chrono::milliseconds (poll_interval_ms), [&w] { return w.stopping; });
+            }
+        }
+    }
+
+    void add(Task *task)
+    {
+        Worker &w = worker();
+        std::lock_guard<std::mutex> lifecycle (w.lifecycle);
+        {
+            std::lock_guard<std::mutex> lock (w.mutex);
+            w.tasks.push_back(task);
+            w.stopping = false;
+        }
+        if (!w.thread.joinable())
+            w.thread = std::thread (run);
+    }
+
+    void remove(Task *task)
+    {
+        Worker &w = worker();
+        std::lock_guard<std::mutex> lifecycle (w.lifecycle);
+        bool is_last;
+        {
+            std::unique_lock<std::mutex> lock (w.mutex);
+            w.tasks.erase(std::remove(w.tasks.begin(), w.tasks.end(), task), w.tasks.end());
+            // not run again once erased; wait out a run in progress
+            w.finished.wait(lock, [&w, task] { return w.running != task; });
+            is_last = w.tasks.empty();
+            if (is_last)
+                w.stopping = true;
+        }
+        if (is_last && w.thread.joinable())
+        {
+            w.wake.notify_one();
+            w.thread.join();
+        }
+    }
+}
@@ -0,0 +1,441 @@
+/*
+  ==============================================================================
+
+    GeometrySwitcher.h
+    Created: 17 Oct 2026 5:53:00am
+    Author:  agent
+
+        One engine per channel, with frame, hop and fft size (and low latency)
+        changeable while audio runs.
+
+    The setters of PhaseVocodeur3 reallocate and reset the engine, so they
+    can't be used from the audio thread. Here a change of geometry builds a
+    whole new set of engines on a background thread instead, and the audio
+    thread moves over to it without allocating or dropping out:
+
+        request_geometry    any thread, only stores the geometry
+        worker thread       builds the engines (and a BatchFFT if they use
+                            one), hands them over through an atomic
+                            pointer, and frees the set they replace
+        process             picks the new set up at the start of a block,
+                            runs it alongside the old one until it is fully
+                            overlap-added, then crossfades to it starting at
+                            one of its hop boundaries
+
+    While warming up, a new engine gets the old one's settings through
+    Engine::begin_warm_up(previous) and analyses the same input, or the
+    old engine's output if that doesn't depend on the input (a frozen
+    JVFreezer), so it takes over the frozen sound. Engine::end_warm_up()
+    is called when the crossfade starts.
+
+    Outside a switch, channels are processed in batches and pairs like the
+    plugin did before, unless the engines run on a FixedVocodeur (preset
+    geometries), whose own real ffts are cheaper than a shared one; during
+    a switch, every engine runs on its own.
+
+    The worker thread is geometry_worker's, one for the whole process: it
+    looks after every switcher every poll_interval_ms, and only exists
+    while at least one switcher does. The audio thread never wakes it, so
+    requesting and switching stay free of locks and system calls.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include "../BatchFFT/BatchFFT.h"
+#include "../PhaseVocodeur3/PhaseVocodeur3.h"
+
+namespace bst = boost::numeric::ublas;
+
+namespace geometry_worker
+{
+    /* something the worker thread looks after */
+    class Task
+    {
+    public:
+        virtual ~Task() = default;
+        /* worker thread, every poll_interval_ms while added */
+        virtual void run() = 0;
+    };
+
+    constexpr int poll_interval_ms = 10;
+
+    /* look after task, starting the thread for the first one */
+    void add(Task *task);
+    /* stop looking after task: once this returns, task's run() has
+       finished and is not called again. The thread ends with the last
+       task. Not from the worker thread. */
+    void remove(Task *task);
+}
+
+template <class Engine>
+class GeometrySwitcher : private geometry_worker::Task
+{
+
+public:
+    struct Geometry
+    {
+        int frame_size;
+        int hop_size;
+        int n_fft;
+        bool low_latency;           // PhaseVocodeur3::set_low_latency
+    };
+
+    GeometrySwitcher(int num_channels, Geometry geometry, int crossfade_length = 1024)
+    : num_channels (num_channels),
+      crossfade_length (std::max(crossfade_length, 1)),
+      requested (pack(geometry))
+    {
+        active = build(geometry);
+
+        previous_out = std::vector<bst::vector<float> > (num_channels, bst::vector<float> (scratch_size, 0.0f));
+        next_out = previous_out;
+
+        /* fade-in gains, the fade-out is the same read backwards:
+           raised cosine, fade_in + fade_out = 1, keeps the level of
+           correlated signals; equal power, fade_in^2 + fade_out^2 = 1, of
+           uncorrelated ones */
+        raised_cosine = bst::vector<float> (this->crossfade_length);
+        equal_power = bst::vector<float> (this->crossfade_length);
+        for (int n = 0; n < this->crossfade_length; n++)
+        {
+            double s = std::sin(0.5 * M_PI * (n + 0.5) / this->crossfade_length);
+            raised_cosine(n) = static_cast<float>(s * s);
+            equal_power(n) = static_cast<float>(s);
+        }
+
+        built = requested.load();
+        geometry_worker::add(this);
+    }
+
+    ~GeometrySwitcher()
+    {
+        geometry_worker::remove(this);
+
+        delete active;
+        delete incoming;
+        delete pending.exchange(nullptr);
+        delete retired.exchange(nullptr);
+    }
+
+    /* switch to this geometry once it is built; realtime-safe. false, and
+       nothing changes, unless 0 < hop_size <= frame_size <= n_fft, n_fft
+       even, and 2 hop_size <= frame_size for low latency */
+    bool request_geometry(int frame_size, int hop_size, int n_fft, bool low_latency = false)
+    {
+        if (hop_size <= 0 || hop_size > frame_size || frame_size > n_fft
+            || n_fft % 2 != 0 || n_fft >= (1 << field_bits)
+            || (low_latency && 2 * hop_size > frame_size))
+            return false;
+
+        requested.store(pack(Geometry {frame_size, hop_size, n_fft, low_latency}));
+        return true;
+    }
+
+    /* audio thread: input[c] -> output[c] for the first num_channels
+       channels (at most the constructor's). input may equal output. */
+    void process(const float *const *input, float *const *output, int num_channels, int num_samples)
+    {
+        num_channels = std::min(num_channels, this->num_channels);
+
+        if (incoming == nullptr)
+            begin_switch();
+
+        if (incoming == nullptr)
+        {
+            process_set(*active, input, output, num_channels, num_samples);
+            return;
+        }
+
+        int n = 0;
+        while (n < num_samples && incoming != nullptr)
+        {
+            // chunks end where the warm up or the crossfade does
+            int chunk = std::min(num_samples - n, scratch_size);
+            if (warm_up_remaining > 0)
+                chunk = std::min(chunk, warm_up_remaining);
+            else
+                chunk = std::min(chunk, crossfade_length - fade_pos);
+
+            for (int c = 0; c < num_channels; c++)
+            {
+                Engine &previous = *active->engines[c];
+                Engine &next = *incoming->engines[c];
+                float *a = &previous_out[c](0);
+                float *b = &next_out[c](0);
+
+                // read input before output is written, they may be the same buffer
+                previous.process(input[c] + n, a, chunk);
+                next.process(previous.depends_on_input() ? input[c] + n : a, b, chunk);
+
+                float *y = output[c] + n;
+                if (warm_up_remaining > 0)
+                {
+                    std::copy(a, a + chunk, y);
+                }
+                else
+                {
+                    const float *g_in = &(*fade_in)(fade_pos);
+                    const float *g_out = &(*fade_in)(crossfade_length - 1 - fade_pos);
+                    for (int i = 0; i < chunk; i++)
+                        y[i] = a[i] * g_out[-i] + b[i] * g_in[i];
+                }
+            }
+
+            if (warm_up_remaining > 0)
+            {
+                warm_up_remaining -= chunk;
+                if (warm_up_remaining == 0)
+                {
+                    for (auto &engine : incoming->engines)
+                        engine->end_warm_up();
+                }
+            }
+            else
+            {
+                fade_pos += chunk;
+                if (fade_pos == crossfade_length)
+                    end_switch();
+            }
+            n += chunk;
+        }
+
+        // rest of the block after a switch completed
+        if (n < num_samples)
+        {
+            for (int c = 0; c < num_channels; c++)
+                active->engines[c]->process(input[c] + n, output[c] + n, num_samples - n);
+        }
+    }
+
+    /* audio thread: f(engine) for every engine that is playing, e.g. to set
+       a parameter on all channels. Engines not picked up yet get the
+       settings of the ones they replace in begin_warm_up. */
+    template <class F>
+    void for_each_engine(F f)
+    {
+        for (auto &engine : active->engines)
+            f(*engine);
+        if (incoming != nullptr)
+        {
+            for (auto &engine : incoming->engines)
+                f(*engine);
+        }
+    }
+
+    /* audio thread: the engine of channel that is being heard (the old one
+       until a switch completes) */
+    Engine& get_engine(int channel)
+    {
+        return *active->engines[channel];
+    }
+
+    Geometry get_geometry()
+    {
+        return active->geometry;
+    }
+
+    bool is_switching()
+    {
+        return incoming != nullptr;
+    }
+
+    /* audio thread: latency of the set being heard, which changes when a
+       switch completes; tail of the longer of the two while switching */
+    int get_latency_samples()
+    {
+        return active->latency_samples;
+    }
+    int get_tail_samples()
+    {
+        if (incoming == nullptr)
+            return active->tail_samples;
+        return std::max(active->tail_samples, incoming->tail_samples);
+    }
+
+private:
+    struct EngineSet
+    {
+        Geometry geometry;
+        std::vector<std::unique_ptr<Engine> > engines;
+        std::unique_ptr<BatchFFT> batch;                // nullptr: no batches
+        bool shares_ffts {false};                       // batches and pairs
+        int latency_samples {0};
+        int tail_samples {0};
+    };
+
+    static constexpr int scratch_size = 512;
+    static constexpr int field_bits = 21;
+
+    int num_channels;
+    int crossfade_length;
+
+    /* audio thread: the set being heard, and the one being switched to */
+    EngineSet *active {nullptr};
+    EngineSet *incoming {nullptr};
+    int warm_up_remaining {0};
+    int fade_pos {0};
+    std::vector<bst::vector<float> > previous_out;
+    std::vector<bst::vector<float> > next_out;
+    bst::vector<float> raised_cosine;
+    bst::vector<float> equal_power;
+    const bst::vector<float> *fade_in {nullptr};    // one of the two, per switch
+
+    /* between threads: the requested geometry, a built set waiting for the
+       audio thread, and a replaced set waiting to be freed */
+    std::atomic<std::uint64_t> requested;
+    std::atomic<EngineSet*> pending {nullptr};
+    std::atomic<EngineSet*> retired {nullptr};
+
+    /* worker thread: the geometry of the last set built */
+    std::uint64_t built;
+
+    static std::uint64_t pack(Geometry g)
+    {
+        return static_cast<std::uint64_t>(g.frame_size)
+             | static_cast<std::uint64_t>(g.hop_size) << field_bits
+             | static_cast<std::uint64_t>(g.n_fft) << (2 * field_bits)
+             | static_cast<std::uint64_t>(g.low_latency) << (3 * field_bits);
+    }
+    static Geometry unpack(std::uint64_t p)
+    {
+        const std::uint64_t mask = (1 << field_bits) - 1;
+        return Geometry {static_cast<int>(p & mask),
+                         static_cast<int>((p >> field_bits) & mask),
+                         static_cast<int>((p >> (2 * field_bits)) & mask),
+                         ((p >> (3 * field_bits)) & 1) != 0};
+    }
+
+    EngineSet* build(Geometry geometry)
+    {
+        std::unique_ptr<EngineSet> set (new EngineSet ());
+        set->geometry = geometry;
+        for (int c = 0; c < num_channels; c++)
+        {
+            set->engines.emplace_back(new Engine (geometry.frame_size, geometry.hop_size, geometry.n_fft));
+            if (geometry.low_latency)
+                set->engines.back()->set_low_latency(true);
+        }
+        if (!set->engines.empty())
+        {
+            set->shares_ffts = !set->engines[0]->is_fixed_vocodeur_active();
+            if (set->shares_ffts && num_channels > 2)
+                set->batch.reset(new BatchFFT (geometry.n_fft));
+            set->latency_samples = set->engines[0]->get_latency_samples();
+            set->tail_samples = set->engines[0]->get_tail_samples();
+        }
+        return set.release();
+    }
+
+    /* worker thread: build what is requested, free what is retired */
+    void run() override
+    {
+        delete retired.exchange(nullptr);
+
+        std::uint64_t geometry = requested.load();
+        if (geometry != built)
+        {
+            built = geometry;
+            try
+            {
+                // a set the audio thread hasn't picked up yet is out of date
+                delete pending.exchange(build(unpack(geometry)));
+            }
+            catch (const std::exception&)
+            {
+                // keep the current set
+            }
+        }
+    }
+
+    /* audio thread: start on a new set, once the last replaced one is freed */
+    void begin_switch()
+    {
+        if (retired.load() != nullptr)
+            return;
+
+        incoming = pending.exchange(nullptr);
+        if (incoming == nullptr)
+            return;
+
+        for (int c = 0; c < num_channels; c++)
+            incoming->engines[c]->begin_warm_up(*active->engines[c]);
+
+        /* a new engine's output only depends on what it has analysed once
+           every frame overlapping it has (2 ola_size samples); round up to
+           its next hop boundary, the first of which is after
+           (ola_size - 1) % hop_size + 1 samples */
+        int ola_size = incoming->geometry.n_fft;
+        int hop_size = incoming->geometry.hop_size;
+        int first_hop = (ola_size - 1) % hop_size + 1;
+        int hops = (2 * ola_size - first_hop + hop_size - 1) / hop_size;
+        warm_up_remaining = first_hop + hops * hop_size;
+        fade_pos = 0;
+
+        // engines with the same latency have outputs that line up; otherwise
+        // they are offset and mostly uncorrelated
+        fade_in = (incoming->latency_samples == active->latency_samples) ? &raised_cosine : &equal_power;
+    }
+
+    /* audio thread: the new set is now the one heard, the old one goes to
+       the worker to be freed */
+    void end_switch()
+    {
+        retired.store(active);
+        active = incoming;
+        incoming = nullptr;
+    }
+
+    /* audio thread: steady state, shared ffts across channels as available */
+    static void process_set(EngineSet &set, const float *const *input, float *const *output,
+                            int num_channels, int num_samples)
+    {
+        if (!set.shares_ffts)
+        {
+            for (int channel = 0; channel < num_channels; channel++)
+                set.engines[channel]->process(input[channel], output[channel], num_samples);
+            return;
+        }
+        
+        // groups of three or four channels share one four-wide fft per hop,
+        // a remaining pair one complex fft
+        int channel = 0;
+        for (; set.batch != nullptr && channel + 2 < num_channels; channel += BatchFFT::max_batch)
+        {
+            int count = std::min(BatchFFT::max_batch, num_channels - channel);
+            PhaseVocodeur3 *engines[BatchFFT::max_batch];
+            for (int i = 0; i < count; i++)
+                engines[i] = set.engines[channel + i].get();
+            PhaseVocodeur3::process_batch(*set.batch, engines, input + channel, output + channel, count, num_samples);
+        }
+        for (; channel + 1 < num_channels; channel += 2)
+        {
+            set.engines[channel]->process_pair(*set.engines[channel + 1],
+                                               input[channel], input[channel + 1],
+                                               output[channel], output[channel + 1], num_samples);
+        }
+        if (channel < num_channels)
+        {
+            set.engines[channel]->process(input[channel], output[channel], num_samples);
+        }
+    }
+
+    GeometrySwitcher(const GeometrySwitcher&) = delete;
+    GeometrySwitcher& operator=(const GeometrySwitcher&) = delete;
+};
+
+template <class Engine>
+constexpr int GeometrySwitcher<Engine>::scratch_size;
+template <class Engine>
+constexpr int GeometrySwitcher<Engine>::field_bits;
@@ -11,92 +11,372 @@
 #include "JVFreezer.h"
 
 JVFreezer::JVFreezer()
-: PhaseVocodeur3(1024, 256, 1024)
+: JVFreezer(1024, 256, 1024)
+{
+    
+}
+
+JVFreezer::JVFreezer(int frame_size, int hop_size, int n_fft)
+: PhaseVocodeur3(frame_size, hop_size, n_fft)
 {
     num_freq_bins = n_fft/2 + 1;
     
-    last_frozen_spectrum = bst::vector<std::complex<float> > (n_fft, 0.0f);
+    last_frozen_spectrum = aligned_vector<std::complex<float> > (num_freq_bins, 0.0f);
     current_frozen_spectrum = last_frozen_spectrum;
     
     cumulative_phase = bst::vector<float> (num_freq_bins, 0.0f);
     phase_advance = cumulative_phase;
     init_phase_advance();
+    
+    init_workspace();
 }
 
-void JVFreezer::spectral_processing(int fr)
+bool JVFreezer::needs_analysis()
 {
-    // copy current frame
-    ola_out(fr) = ola_in(fr);
-    // apply window
-    ola_out(fr) = bst::element_prod(ola_out(fr), window);
-    
-    // transform
-    bst::vector<std::complex<float> > spectrum = jv_bst::fft(ola_out(fr), fft_forward);
+    // the frozen spectrum does not depend on the input
+    return !is_freeze_active;
+}
+
+bool JVFreezer::modify_spectrum()
+{
+    /* runs on the audio thread: only touches preallocated containers */
     
     if (!is_freeze_active)
     {
-        last_frozen_spectrum = current_frozen_spectrum;
-        current_frozen_spectrum = spectrum;
+        // current becomes last, analysis spectrum becomes current
+        last_frozen_spectrum.swap(current_frozen_spectrum);
+        bst::noalias(current_frozen_spectrum) = spectrum;
+        
+        fast_math::car2pol(&current_frozen_spectrum(0), nullptr, &cumulative_phase(0), num_freq_bins);
+        publish_magnitude(nullptr);
+        is_phasor_ready = false;
+        is_bank_playing = false;
         
-        cumulative_phase = jv_bst::angle(current_frozen_spectrum);
-        cumulative_phase.resize(num_freq_bins, true);
+        // output the windowed input frame as is
+        return false;
     }
     
-    if (is_freeze_active)
+    if (is_bank_active())
+        synthesize_bank();
+    else if (use_phasor_synthesis)
+        synthesize_phasor();
+    else
+        synthesize_polar();
+    
+    // resynthesize with the resynthesis window
+    return true;
+}
+
+void JVFreezer::update_phase_increment()
+{
+    /* mX and dp from the two stored spectra, through the out-param
+       kernels: they dispatch to AVX2, the fused expressions stop at SSE2 */
+    fast_math::car2pol(&current_frozen_spectrum(0), &mX(0), &dp(0), num_freq_bins);
+    fast_math::car2pol(&last_frozen_spectrum(0), nullptr, &last_phase(0), num_freq_bins);
+    
+    bst::noalias(dp) = dp - last_phase - phase_advance;
+    jv_bst::wrap_to_pi(dp, dp);
+    
+    if (is_low_latency_active())
+        lock_phase_increment();
+}
+
+void JVFreezer::lock_phase_increment()
+{
+    /* identity phase locking: every bin turns by the increment of the peak
+       whose lobe it is in (peak to lowest bin before the next peak), so each
+       lobe is rotated as a whole. The low latency synthesis window only
+       keeps the last 2 hops of the frame, and lobe bins turning by their
+       own increments smear a tone out of them. */
+    int start = 0;
+    int peak = find_peak(0);
+    while (peak < num_freq_bins)
     {
-        // truncate
-        bst::vector<std::complex<float> > Xcurrent (num_freq_bins, 0.0f);
-        bst::vector<std::complex<float> > Xlast (num_freq_bins, 0.0f);
-        
-        std::copy(current_frozen_spectrum.begin(), current_frozen_spectrum.begin() + num_freq_bins, Xcurrent.begin());
-        std::copy(last_frozen_spectrum.begin(), last_frozen_spectrum.begin()+num_freq_bins, Xlast.begin());
-        
-        // current magnitude
-        bst::vector<float> mX = jv_bst::abs(Xcurrent);
-        
-        // phase advance
-        bst::vector<float> current_phase = jv_bst::angle(Xcurrent);
-        bst::vector<float> last_phase = jv_bst::angle(Xlast);
-        bst::vector<float> dp = current_phase - last_phase - phase_advance;
-        dp = jv_bst::wrap_to_pi(dp);
-        
-        // output half-spectrum
-        bst::vector<std::complex<float> > Y = jv_bst::pol2cart(mX, cumulative_phase);
-        
-        // form whole spectrum
-        bst::vector<std::complex<float> > Y_whole (n_fft, 0.0f);
-        std::copy(Y.begin(), Y.begin()+num_freq_bins, Y_whole.begin());
+        int next = find_peak(peak + 1);
+        int end = num_freq_bins;
+        if (next < num_freq_bins)
+        {
+            end = next;
+            for (int k = peak + 1; k < next; k++)
+            {
+                if (mX(k) < mX(end))
+                    end = k;
+            }
+        }
         
-            // hermitian symmetry
-        int k = num_freq_bins-2;
-        for (int n = num_freq_bins; n < n_fft; n++)
+        float peak_increment = phase_advance(peak) + dp(peak);
+        for (int k = start; k < end; k++)
         {
-            Y_whole(n) = std::conj(Y(k));
-            
-            k--;
+            dp(k) = peak_increment - phase_advance(k);
         }
         
-        // inverse transform
-        bst::vector<float> y = jv_bst::real(jv_bst::fft(Y_whole, fft_inverse));
+        start = end;
+        peak = next;
+    }
+}
+
+int JVFreezer::find_peak(int from)
+{
+    /* first local maximum of mX at or after from, else num_freq_bins */
+    for (int k = from; k < num_freq_bins; k++)
+    {
+        bool above_left = (k == 0) || mX(k) > mX(k - 1);
+        bool above_right = (k == num_freq_bins - 1) || mX(k) >= mX(k + 1);
+        if (above_left && above_right)
+            return k;
+    }
+    return num_freq_bins;
+}
+
+void JVFreezer::synthesize_polar()
+{
+    update_phase_increment();
+    is_bank_playing = false;
+    
+    if (is_phasor_ready)
+    {
+        // switched from phasor synthesis mid-freeze: continue its phase
+        // (the phasor is already a hop on)
+        for (int k = 0; k < num_freq_bins; k++)
+        {
+            cumulative_phase(k) = std::arg(phasor(k)) - phase_advance(k) - dp(k);
+        }
+        is_phasor_ready = false;
+    }
+    
+    publish_magnitude(&mX(0));
+    
+    // advance cumulative phase: the first frozen hop continues the last
+    // analysed one, as the input would have
+    bst::noalias(cumulative_phase) = cumulative_phase + phase_advance + dp;
+    jv_bst::wrap_to_pi(cumulative_phase, cumulative_phase);
+    
+    // output half-spectrum
+    fast_math::pol2car(&mX(0), &cumulative_phase(0), &spectrum(0), num_freq_bins);
+}
+
+void JVFreezer::synthesize_phasor()
+{
+    if (!is_phasor_ready)
+        init_phasors();
+    is_bank_playing = false;
+    
+    publish_magnitude(&mX(0));
+    
+    // output half-spectrum, then advance each bin by its rotation
+    bst::noalias(spectrum) = phasor;
+    for (int k = 0; k < num_freq_bins; k++)
+    {
+        phasor(k) *= rotation(k);
+    }
+    
+    // rounding in the multiplies slowly changes |phasor|: reset it to mX
+    if (++hops_since_renormalize >= renormalize_interval)
+    {
+        for (int k = 0; k < num_freq_bins; k++)
+        {
+            float magnitude = std::abs(phasor(k));
+            if (magnitude > 0.0f)
+                phasor(k) *= mX(k) / magnitude;
+        }
+        hops_since_renormalize = 0;
+    }
+}
+
+void JVFreezer::synthesize_bank()
+{
+    /* the polar loop, with mX and dp decoded from the bank, or morphed from
+       the live pair's to a slot */
+    if (is_phasor_ready)
+    {
+        // switched from phasor synthesis mid-freeze: continue the phase it
+        // last output (the phasor is already a hop on)
+        for (int k = 0; k < num_freq_bins; k++)
+        {
+            cumulative_phase(k) = std::arg(phasor(k) * std::conj(rotation(k)));
+        }
+        is_phasor_ready = false;
+    }
+    
+    // from the live freeze (is_bank_active: then to_slot has a capture)
+    bool from_live = !freeze_bank->matches(bank_from, bank_channel, num_freq_bins, hop_size);
+    int from_slot = from_live ? bank_to : bank_from;
+    if (from_live)
+        update_phase_increment();
+    
+    const std::uint16_t *from_magnitude = freeze_bank->get_magnitudes(from_slot, bank_channel);
+    const std::int16_t *from_increment = freeze_bank->get_increments(from_slot, bank_channel);
+    const std::uint16_t *to_magnitude = from_magnitude;
+    const std::int16_t *to_increment = from_increment;
+    float t = 0.0f;
+    if (freeze_bank->matches(bank_to, bank_channel, num_freq_bins, hop_size))
+    {
+        to_magnitude = freeze_bank->get_magnitudes(bank_to, bank_channel);
+        to_increment = freeze_bank->get_increments(bank_to, bank_channel);
+        t = bank_morph;
+    }
+    
+    for (int k = 0; k < num_freq_bins; k++)
+    {
+        // from: in increment units, unrounded for the live pair, so it
+        // plays unchanged at t = 0
+        float from_m, from_units;
+        int from_wrapped;
+        if (from_live)
+        {
+            from_m = mX(k);
+            from_units = (phase_advance(k) + dp(k)) / FreezeBank::increment_scale;
+            from_wrapped = FreezeBank::increment_to_units(phase_advance(k) + dp(k));
+        }
+        else
+        {
+            from_m = FreezeBank::half_to_float(from_magnitude[k]);
+            from_units = from_increment[k];
+            from_wrapped = from_increment[k];
+        }
         
-        // advance cumulative phase
-        bst::vector<float> temp = cumulative_phase + phase_advance + dp;
-        cumulative_phase = jv_bst::wrap_to_pi(temp);
+        float a = (1.0f - t) * from_m;
+        float b = t * FreezeBank::half_to_float(to_magnitude[k]);
+        mX(k) = a + b;
         
-        // store
-        ola_out(fr) = bst::element_prod(y, window) * (4.0/3.0);
+        // move the increment by the share of the magnitude from to_slot,
+        // so a bin only one side has energy in keeps that side's frequency,
+        // the shortest way round in the increments' 16 bits
+        float share = (mX(k) > 0.0f) ? b / mX(k) : t;
+        int difference = ((to_increment[k] - from_wrapped + 32768) & 0xffff) - 32768;
+        float increment = (from_units + share * difference) * FreezeBank::increment_scale;
+        dp(k) = increment - phase_advance(k);
     }
+    is_bank_playing = true;
+    
+    publish_magnitude(&mX(0));
     
+    // advance cumulative phase
+    bst::noalias(cumulative_phase) = cumulative_phase + phase_advance + dp;
+    jv_bst::wrap_to_pi(cumulative_phase, cumulative_phase);
+    
+    // output half-spectrum
+    fast_math::pol2car(&mX(0), &cumulative_phase(0), &spectrum(0), num_freq_bins);
+}
+
+bool JVFreezer::is_bank_active()
+{
+    // a slot to play from, or the live freeze morphing to one
+    return freeze_bank != nullptr
+        && (freeze_bank->matches(bank_from, bank_channel, num_freq_bins, hop_size)
+            || freeze_bank->matches(bank_to, bank_channel, num_freq_bins, hop_size));
+}
+
+void JVFreezer::init_phasors()
+{
+    /* once per freeze: the only trigonometry on the phasor path */
+    update_phase_increment();
+    
+    // a hop on from cumulative_phase, the last analysed (or output) hop
+    for (int k = 0; k < num_freq_bins; k++)
+    {
+        rotation(k) = std::polar(1.0f, phase_advance(k) + dp(k));
+        phasor(k) = std::polar(mX(k), cumulative_phase(k)) * rotation(k);
+    }
+    
+    hops_since_renormalize = 0;
+    is_phasor_ready = true;
+}
+
+const float* JVFreezer::get_resynthesis_window()
+{
+    // the analysis taper again (or nothing, under a tapering synthesis
+    // window), with the overlap-add gain
+    return &windows->resynthesis(0);
 }
 
 void JVFreezer::set_is_freeze_active(bool is_freeze_active)
 {
-    this->is_freeze_active = is_freeze_active;
+    if (is_warming_up)
+        freeze_after_warm_up = is_freeze_active;
+    else
+        this->is_freeze_active = is_freeze_active;
 }
 
-bst::vector<float> JVFreezer::get_magnitude()
+void JVFreezer::set_use_phasor_synthesis(bool use_phasor_synthesis)
 {
-    return jv_bst::abs(current_frozen_spectrum);
+    this->use_phasor_synthesis = use_phasor_synthesis;
+}
+
+void JVFreezer::set_magnitude_snapshot(SpectrumSnapshot *snapshot)
+{
+    magnitude_snapshot = snapshot;
+}
+
+void JVFreezer::set_freeze_bank(FreezeBank *bank, int channel)
+{
+    freeze_bank = bank;
+    bank_channel = channel;
+}
+
+void JVFreezer::capture_to_bank(int slot)
+{
+    if (freeze_bank == nullptr)
+        return;
+    
+    // the bank's last hop as heard, or the live pair's
+    if (!(is_freeze_active && is_bank_playing))
+        update_phase_increment();
+    
+    jv_bst::noalias(increment) = jv_bst::add(phase_advance, dp);
+    freeze_bank->store(slot, bank_channel, &mX(0), &increment(0), num_freq_bins, hop_size);
+}
+
+void JVFreezer::set_bank_morph(int from_slot, int to_slot, float amount)
+{
+    bank_from = from_slot;
+    bank_to = to_slot;
+    bank_morph = std::min(std::max(amount, 0.0f), 1.0f);
+}
+
+void JVFreezer::begin_warm_up(JVFreezer &previous)
+{
+    PhaseVocodeur3::begin_warm_up(previous);
+    
+    use_phasor_synthesis = previous.use_phasor_synthesis;
+    
+    freeze_bank = previous.freeze_bank;
+    bank_channel = previous.bank_channel;
+    set_bank_morph(previous.bank_from, previous.bank_to, previous.bank_morph);
+    
+    // only one engine publishes
+    magnitude_snapshot = previous.magnitude_snapshot;
+    previous.magnitude_snapshot = nullptr;
+    
+    // a frozen previous is analysed through its output, freeze once done
+    is_warming_up = true;
+    freeze_after_warm_up = previous.is_freeze_active;
+    is_freeze_active = false;
+}
+
+void JVFreezer::end_warm_up()
+{
+    is_warming_up = false;
+    is_freeze_active = freeze_after_warm_up;
+}
+
+void JVFreezer::publish_magnitude(const float *magnitude)
+{
+    /* |current_frozen_spectrum|, or magnitude if already computed */
+    if (magnitude_snapshot == nullptr)
+        return;
+    
+    int size = std::min(num_freq_bins, magnitude_snapshot->get_capacity());
+    float *m = magnitude_snapshot->get_write_buffer();
+    if (magnitude != nullptr)
+    {
+        std::copy(magnitude, magnitude + size, m);
+    }
+    else
+    {
+        fast_math::car2pol(&current_frozen_spectrum(0), m, nullptr, size);
+    }
+    magnitude_snapshot->publish(size);
 }
 
 void JVFreezer::init_phase_advance()
@@ -109,3 +389,14 @@ void JVFreezer::init_phase_advance()
         phase_advance(n) = phi;
     }
 }
+
+void JVFreezer::init_workspace()
+{
+    /* allocate everything spectral_processing needs, once */
+    mX              = bst::vector<float> (num_freq_bins, 0.0f);
+    dp              = bst::vector<float> (num_freq_bins, 0.0f);
+    last_phase      = dp;
+    phasor          = aligned_vector<std::complex<float> > (num_freq_bins, 0.0f);
+    rotation        = phasor;
+    increment       = mX;
+}
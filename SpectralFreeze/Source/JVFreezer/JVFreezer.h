@@ -10,6 +10,21 @@
         When is_freeze_active is set to true, then oscillates last filled
         buffer using cumulative phase advance.
  
+        The per-bin phase increment is constant while frozen, so by default
+        each bin is a phasor rotated by one complex multiply per hop (no
+        trigonometry after the first frozen hop). set_use_phasor_synthesis
+        (false) selects the original polar resynthesis from cumulative_phase.
+ 
+        In low latency mode the increments are phase locked: each bin takes
+        that of the spectral peak it sits under, so the short synthesis
+        window keeps a frozen tone's level.
+ 
+        With a FreezeBank, capture_to_bank stores the freeze (magnitudes
+        and per-bin phase increments) in a slot, and set_bank_morph plays
+        slots instead of the live freeze: one, or per-bin interpolation
+        from one (or from the live freeze) to another, decoded in the polar
+        synthesis loop. Both only index the preallocated bank.
+ 
   ==============================================================================
 */
 
@@ -19,7 +34,10 @@
 
 #include <boost/numeric/ublas/vector.hpp>
 
+#include "../FastMath/FastMath.h"
+#include "../FreezeBank/FreezeBank.h"
 #include "../PhaseVocodeur3/PhaseVocodeur3.h"
+#include "../SpectrumSnapshot/SpectrumSnapshot.h"
 #include "../VectorOperations2/VectorOperations2.h"
 #include "../Windows/Windows.h"
 
@@ -31,22 +49,84 @@ class JVFreezer: public PhaseVocodeur3
 public:
     
     JVFreezer();
-    
-    void spectral_processing(int fr) override;
+    JVFreezer(int frame_size, int hop_size, int n_fft);
     
     void set_is_freeze_active(bool is_freeze_active);
+    void set_use_phasor_synthesis(bool use_phasor_synthesis);
     
-    bst::vector<float> get_magnitude();
+    /* publish the frozen magnitude spectrum to snapshot once per hop
+       (nullptr: don't publish) */
+    void set_magnitude_snapshot(SpectrumSnapshot *snapshot);
+    
+    /* slots of bank hold this channel (nullptr: no bank) */
+    void set_freeze_bank(FreezeBank *bank, int channel);
+    /* store what is heard when frozen, else the last analysed hops, in
+       slot. Audio thread, between blocks. */
+    void capture_to_bank(int slot);
+    /* play bank slots while frozen: from_slot, morphing per bin toward
+       to_slot by amount in [0, 1]. A slot of -1, or one without a capture
+       at this geometry, is the live freeze (from) or from alone (to).
+       Constant time. */
+    void set_bank_morph(int from_slot, int to_slot, float amount);
+    
+    /* geometry changes: take over previous's settings and snapshot, and stay
+       unfrozen to analyse until end_warm_up */
+    void begin_warm_up(JVFreezer &previous);
+    void end_warm_up();
 private:
     
     int num_freq_bins {513};
     
-    bst::vector<std::complex<float> > current_frozen_spectrum;
-    bst::vector<std::complex<float> > last_frozen_spectrum;
+    /* half-spectra (num_freq_bins) */
+    aligned_vector<std::complex<float> > current_frozen_spectrum;
+    aligned_vector<std::complex<float> > last_frozen_spectrum;
     bst::vector<float> cumulative_phase;
     bst::vector<float> phase_advance;
     
     bool is_freeze_active {false};
+    bool is_warming_up {false};
+    bool freeze_after_warm_up {false};              // set_is_freeze_active while warming up
+    
+    /* phasor synthesis: spectrum = phasor, phasor *= rotation each hop */
+    bool use_phasor_synthesis {true};
+    bool is_phasor_ready {false};                   // set on the first frozen hop
+    aligned_vector<std::complex<float> > phasor;
+    aligned_vector<std::complex<float> > rotation;
+    int hops_since_renormalize {0};
+    static constexpr int renormalize_interval {64}; // hops between magnitude resets
+    
+    SpectrumSnapshot *magnitude_snapshot {nullptr};
+    
+    /* set_freeze_bank and set_bank_morph */
+    FreezeBank *freeze_bank {nullptr};
+    int bank_channel {0};
+    int bank_from {-1};
+    int bank_to {-1};
+    float bank_morph {0.0f};
+    bool is_bank_playing {false};                   // mX and dp are the bank's
+    
+    /* modify_spectrum workspace, preallocated by init_workspace() */
+    bst::vector<float> mX, dp;
+    bst::vector<float> last_phase;                  // update_phase_increment
+    bst::vector<float> increment;                   // capture_to_bank
+    
+    /* spectral processing stages */
+    bool needs_analysis() override;
+    bool modify_spectrum() override;
+    const float* get_resynthesis_window() override;
+    
+    void publish_magnitude(const float *magnitude);
+    
+    /* frozen hop synthesis */
+    void update_phase_increment();
+    void lock_phase_increment();                    // low latency only
+    int find_peak(int from);
+    void synthesize_polar();
+    void synthesize_phasor();
+    void synthesize_bank();
+    void init_phasors();
+    bool is_bank_active();
     
     void init_phase_advance();
+    void init_workspace();
 };
@@ -0,0 +1,373 @@
+/*
+  ==============================================================================
+
+    MultiResolutionFreezer.cpp
+    Created: 17 Oct 2026 6:56:51am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "MultiResolutionFreezer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../FastMath/FastMathLanes.h"
+#include "../Windows/Windows.h"
+
+namespace
+{
+    /* bands, lowest first: the crossover the band keeps whole below (0 for
+       the top band), the rate the band runs at (0 for the full rate) and
+       its fft size at that rate (48 kHz for the full rate), frame_size
+       n_fft and hop_size n_fft / 2 (FixedVocodeur presets). A third band
+       costs more in full rate filtering than its fft saves */
+    struct BandSpec { double crossover_hz, rate_hz; int n_fft; };
+    const BandSpec band_specs[] = {
+        {300.0,     3000.0,     256},
+        {0.0,       0.0,        1024},
+    };
+    const double full_rate_hz = 48000.0;
+
+    /* nearest power of two to ratio, at least 1 */
+    int nearest_power_of_two(double ratio)
+    {
+        return 1 << std::max(0, static_cast<int>(std::lround(std::log2(ratio))));
+    }
+
+    /* split filters' stopband, and kaiser's beta for it */
+    const double stopband_db = 60.0;
+    const double kaiser_beta = 0.1102 * (stopband_db - 8.7);
+
+#if FAST_MATH_X86
+    typedef fast_math::detail::Sse2 Lanes;
+#else
+    typedef fast_math::detail::Scalar Lanes;
+#endif
+
+    /* filters are zero-padded to a multiple of this, for dot(), and
+       interpolator rows to a multiple of accumulators */
+    const int accumulators = 4;
+    const int dot_block = accumulators * Lanes::width;
+
+    /* a . b over len, a multiple of dot_block: independent partial sums,
+       so the multiply-adds don't wait on each other */
+    inline float dot(const float *a, const float *b, int len)
+    {
+        Lanes::V s0 = Lanes::set1(0.0f), s1 = s0, s2 = s0, s3 = s0;
+        for (int k = 0; k < len; k += dot_block)
+        {
+            s0 = Lanes::fmadd(Lanes::load(a + k),                    Lanes::load(b + k),                    s0);
+            s1 = Lanes::fmadd(Lanes::load(a + k + Lanes::width),     Lanes::load(b + k + Lanes::width),     s1);
+            s2 = Lanes::fmadd(Lanes::load(a + k + 2 * Lanes::width), Lanes::load(b + k + 2 * Lanes::width), s2);
+            s3 = Lanes::fmadd(Lanes::load(a + k + 3 * Lanes::width), Lanes::load(b + k + 3 * Lanes::width), s3);
+        }
+        float sum[Lanes::width];
+        Lanes::store(sum, Lanes::add(Lanes::add(s0, s1), Lanes::add(s2, s3)));
+        float total = 0.0f;
+        for (int i = 0; i < Lanes::width; i++)
+        {
+            total += sum[i];
+        }
+        return total;
+    }
+
+    int round_up(int n, int multiple)
+    {
+        return (n + multiple - 1) / multiple * multiple;
+    }
+
+    /* odd length kaiser windowed sinc lowpass with unity gain at dc, from
+       pass to stop in cycles per sample */
+    bst::vector<float> design_lowpass(double pass, double stop)
+    {
+        // kaiser's length estimate for the stopband
+        int len = static_cast<int>(std::ceil((stopband_db - 8.0) / (2.285 * 2.0 * M_PI * (stop - pass)))) + 1;
+        len |= 1;
+
+        // symmetric window: the periodic one a sample shorter, plus its end
+        bst::vector<float> h (len);
+        kaiser(&h(0), len - 1, kaiser_beta);
+        h(len - 1) = h(0);
+
+        double cutoff = 0.5 * (pass + stop);
+        int centre = (len - 1) / 2;
+        double sum = 0.0;
+        for (int n = 0; n < len; n++)
+        {
+            double t = n - centre;
+            double sinc = (t == 0.0) ? 2.0 * cutoff : std::sin(2.0 * M_PI * cutoff * t) / (M_PI * t);
+            h(n) = static_cast<float>(h(n) * sinc);
+            sum += h(n);
+        }
+        h /= static_cast<float>(sum);
+        return h;
+    }
+}
+
+// std::min takes it by reference
+constexpr int MultiResolutionFreezer::max_chunk;
+
+MultiResolutionFreezer::MultiResolutionFreezer(double sample_rate)
+{
+    const int num_bands = sizeof(band_specs) / sizeof(band_specs[0]);
+    bands.resize(num_bands);
+
+    // top down: each band's rate, a power of two below the band above's,
+    // and chunk sizes
+    int decimation = 1;
+    int capacity = max_chunk;
+    for (int i = num_bands - 1; i >= 0; i--)
+    {
+        Band &band = bands[i];
+        double rate_hz = band_specs[i].rate_hz;
+        if (rate_hz > 0.0)
+        {
+            int split_decimation = std::max(2, nearest_power_of_two(sample_rate / rate_hz) / decimation);
+            bands[i + 1].split_decimation = split_decimation;
+            decimation *= split_decimation;
+            capacity = capacity / split_decimation + 1;
+
+            band.input = bst::vector<float> (capacity, 0.0f);
+            band.output = band.input;
+        }
+        band.decimation = decimation;
+
+        // the same resolution in Hz at any sample rate
+        double nominal_rate = (rate_hz > 0.0) ? rate_hz : full_rate_hz;
+        int n_fft = band_specs[i].n_fft * nearest_power_of_two(sample_rate / decimation / nominal_rate);
+        band.freezer.reset(new JVFreezer (n_fft, n_fft/2, n_fft));
+        band.own = bst::vector<float> (capacity, 0.0f);
+        band.below = band.own;
+    }
+
+    // bottom up: splits, and the delays that line each band up with the
+    // band below
+    bands[0].latency = bands[0].freezer->get_latency_samples();
+    int tail = bands[0].freezer->get_tail_samples();
+    for (int i = 1; i < num_bands; i++)
+    {
+        Band &band = bands[i];
+        const Band &lower = bands[i - 1];
+        int D = band.split_decimation;
+
+        // pass what the band below keeps whole, stop at its nyquist
+        double rate = sample_rate / band.decimation;
+        bst::vector<float> lowpass = design_lowpass(band_specs[i - 1].crossover_hz / rate, 0.5 / D);
+        int len = static_cast<int>(lowpass.size());
+
+        // zero taps on the oldest inputs, so dot() can run over all of them
+        band.filter_length = len;
+        band.num_taps = round_up(len, dot_block);
+        band.lowpass = bst::vector<float> (band.num_taps, 0.0f);
+        std::copy(lowpass.begin(), lowpass.end(), band.lowpass.end() - len);
+        int chunk = static_cast<int>(band.own.size());
+        band.input_history = bst::vector<float> (band.num_taps - 1 + chunk, 0.0f);
+
+        // sample m - j from below contributes tap p + j D to phase p (zero
+        // phases past D and rows past the filter, for whole vectors)
+        int P = round_up((len + D - 1) / D, accumulators);
+        band.num_phase_taps = P;
+        band.num_phases = round_up(D, Lanes::width);
+        band.polyphase = bst::vector<float> (P * band.num_phases, 0.0f);
+        for (int j = 0; j < P; j++)
+        {
+            for (int p = 0; p < D && p + j * D < len; p++)
+            {
+                band.polyphase((P - 1 - j) * band.num_phases + p) = D * lowpass(p + j * D);
+            }
+        }
+        for (Interpolator *interpolator : {&band.split, &band.merge})
+        {
+            interpolator->history = bst::vector<float> (P - 1 + lower.input.size(), 0.0f);
+            interpolator->group = bst::vector<float> (band.num_phases, 0.0f);
+        }
+
+        // the lowpass delays by (len - 1) / 2 each way, so the input is
+        // taken len - 1 late to meet it, and the band below's output comes
+        // back up D * its latency after that (the band below is always the
+        // slower)
+        band.output_delay = bst::vector<float> (D * lower.latency - band.freezer->get_latency_samples(), 0.0f);
+        band.latency = len - 1 + D * lower.latency;
+        tail = len - 1 + D * tail;
+    }
+
+    latency_samples = bands.back().latency;
+    tail_samples = tail;
+}
+
+void MultiResolutionFreezer::process(const float *input, float *output, int num_samples)
+{
+    /* runs on the audio thread: only touches preallocated containers */
+    for (int n = 0; n < num_samples; n += max_chunk)
+    {
+        int chunk = std::min(max_chunk, num_samples - n);
+        process_band(static_cast<int>(bands.size()) - 1, input + n, output + n, chunk);
+    }
+}
+
+void MultiResolutionFreezer::process_band(int index, const float *input, float *output, int num_samples)
+{
+    Band &band = bands[index];
+    if (index == 0)
+    {
+        band.freezer->process(input, output, num_samples);
+        return;
+    }
+
+    Band &lower = bands[index - 1];
+    float *own = &band.own(0);
+    float *below = &band.below(0);
+
+    /* split: the band below's input, and back up to take off the input
+       (read before output is written, so they may be the same), taken
+       from the history as late as the lowpass both ways */
+    float *history = &band.input_history(0);
+    int L = band.num_taps;
+    std::copy(input, input + num_samples, history + L - 1);
+    int count = decimate(band, history, &lower.input(0), num_samples);
+    interpolate(band, band.split, &lower.input(0), count, below, num_samples);
+    const float *delayed = history + L - band.filter_length;
+    for (int n = 0; n < num_samples; n++)
+    {
+        own[n] = delayed[n] - below[n];
+    }
+    std::copy(history + num_samples, history + num_samples + L - 1, history);
+
+    band.freezer->process(own, own, num_samples);
+    delay(band.output_delay, band.output_delay_pos, own, num_samples);
+
+    /* merge: the band below's output back up */
+    process_band(index - 1, &lower.input(0), &lower.output(0), count);
+    interpolate(band, band.merge, &lower.output(0), count, below, num_samples);
+    for (int n = 0; n < num_samples; n++)
+    {
+        output[n] = own[n] + below[n];
+    }
+
+    band.phase = (band.phase + num_samples) % band.split_decimation;
+}
+
+int MultiResolutionFreezer::decimate(Band &band, const float *history, float *below, int num_samples)
+{
+    /* a sample for below from every D-th input, at phase 0: history holds
+       the num_taps - 1 inputs before, so the last num_taps from input n
+       start at n */
+    int D = band.split_decimation;
+    int L = band.num_taps;
+    const float *h = &band.lowpass(0);
+    int count = 0;
+    for (int n = (D - band.phase) % D; n < num_samples; n += D)
+    {
+        below[count++] = dot(h, history + n, L);
+    }
+    return count;
+}
+
+void MultiResolutionFreezer::interpolate(Band &band, Interpolator &interpolator, const float *below, int count,
+                                         float *output, int num_samples)
+{
+    /* each sample from below gives the next D outputs at once: per vector
+       of phases, one multiply-add per row, across independent partial
+       sums */
+    int D = band.split_decimation;
+    int P = band.num_phase_taps;
+    int num_phases = band.num_phases;
+    const float *polyphase = &band.polyphase(0);
+    float *history = &interpolator.history(0);
+    float *group = &interpolator.group(0);
+    std::copy(below, below + count, history + P - 1);
+
+    // the rest of the last group, then a group per sample from below
+    int phase = band.phase;
+    int first = (D - phase) % D;
+    for (int n = 0; n < first && n < num_samples; n++)
+    {
+        output[n] = group[phase + n];
+    }
+    for (int m = 0; m < count; m++)
+    {
+        // straight into output when the whole group fits, else through
+        // group, which keeps the rest for the next block
+        int start = first + m * D;
+        bool is_whole = num_phases == D && start + D <= num_samples;
+        float *to = is_whole ? output + start : group;
+
+        const float *x = history + m;
+        for (int p = 0; p < num_phases; p += Lanes::width)
+        {
+            const float *c = polyphase + p;
+            Lanes::V s0 = Lanes::set1(0.0f), s1 = s0, s2 = s0, s3 = s0;
+            for (int j = 0; j < P; j += accumulators)
+            {
+                s0 = Lanes::fmadd(Lanes::load(c + j * num_phases),       Lanes::set1(x[j]),     s0);
+                s1 = Lanes::fmadd(Lanes::load(c + (j + 1) * num_phases), Lanes::set1(x[j + 1]), s1);
+                s2 = Lanes::fmadd(Lanes::load(c + (j + 2) * num_phases), Lanes::set1(x[j + 2]), s2);
+                s3 = Lanes::fmadd(Lanes::load(c + (j + 3) * num_phases), Lanes::set1(x[j + 3]), s3);
+            }
+            Lanes::store(to + p, Lanes::add(Lanes::add(s0, s1), Lanes::add(s2, s3)));
+        }
+
+        if (!is_whole)
+        {
+            int end = std::min(num_samples, start + D);
+            for (int n = start; n < end; n++)
+            {
+                output[n] = group[n - start];
+            }
+        }
+    }
+    std::copy(history + count, history + count + P - 1, history);
+}
+
+void MultiResolutionFreezer::delay(bst::vector<float> &line, int &pos, float *x, int num_samples)
+{
+    /* swap x through the ring, a contiguous run at a time */
+    int size = static_cast<int>(line.size());
+    if (size == 0)
+        return;
+    for (int n = 0; n < num_samples; )
+    {
+        int run = std::min(num_samples - n, size - pos);
+        std::swap_ranges(x + n, x + n + run, &line(pos));
+        n += run;
+        pos = (pos + run == size) ? 0 : pos + run;
+    }
+}
+
+//============ Settings ===========================================================
+
+void MultiResolutionFreezer::set_is_freeze_active(bool is_freeze_active)
+{
+    for (auto &band : bands)
+        band.freezer->set_is_freeze_active(is_freeze_active);
+}
+void MultiResolutionFreezer::set_use_phasor_synthesis(bool use_phasor_synthesis)
+{
+    for (auto &band : bands)
+        band.freezer->set_use_phasor_synthesis(use_phasor_synthesis);
+}
+
+//============ Getters ============================================================
+
+int MultiResolutionFreezer::get_latency_samples()
+{
+    return latency_samples;
+}
+int MultiResolutionFreezer::get_tail_samples()
+{
+    return tail_samples;
+}
+int MultiResolutionFreezer::get_num_bands()
+{
+    return static_cast<int>(bands.size());
+}
+int MultiResolutionFreezer::get_band_decimation(int band)
+{
+    return bands[band].decimation;
+}
+JVFreezer& MultiResolutionFreezer::get_band_freezer(int band)
+{
+    return *bands[band].freezer;
+}
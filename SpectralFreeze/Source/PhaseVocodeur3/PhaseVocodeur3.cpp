@@ -15,6 +15,7 @@ PhaseVocodeur3::PhaseVocodeur3()
     init_ola();
     init_window();
     init_fft();
+    init_fixed_vocodeur();
 }
 
 PhaseVocodeur3::PhaseVocodeur3(int frame_size, int hop_size)
@@ -27,6 +28,7 @@ PhaseVocodeur3::PhaseVocodeur3(int frame_size, int hop_size)
     init_ola();
     init_window();
     init_fft();
+    init_fixed_vocodeur();
 }
 
 PhaseVocodeur3::PhaseVocodeur3(int frame_size, int hop_size, int n_fft)
@@ -39,6 +41,7 @@ PhaseVocodeur3::PhaseVocodeur3(int frame_size, int hop_size, int n_fft)
     init_ola();
     init_window();
     init_fft();
+    init_fixed_vocodeur();
 }
 
 PhaseVocodeur3::~PhaseVocodeur3()
@@ -50,53 +53,373 @@ PhaseVocodeur3::~PhaseVocodeur3()
 
 void PhaseVocodeur3::push(float input_sample)
 {
-    /* write input to overlapping buffers */
-    for (int fr = 0; fr < num_ola_frames; fr++)
+    /* write input once to the history ring */
+    input_history(history_pos) = input_sample;
+    history_pos = (history_pos + 1) % ola_size;
+    
+    // at a hop boundary, transform and overlap-add after the current sample
+    if (--samples_to_hop == 0)
     {
-        ola_in(fr)(rw[fr]) = input_sample;
-        // if full, transform
-        if (rw[fr] == ola_size - 1)
+        spectral_processing();
+        overlap_add((acc_pos + 1) % acc_size);
+        samples_to_hop = hop_size;
+    }
+}
+
+void PhaseVocodeur3::advance()
+{
+    // consume the current output sample
+    output_accumulator(acc_pos) = 0.0f;
+    acc_pos = (acc_pos + 1) % acc_size;
+}
+
+float PhaseVocodeur3::read_sum()
+{
+    /* overlap-added output, normalization is in the synthesis window */
+    return output_accumulator(acc_pos);
+}
+
+void PhaseVocodeur3::process(const float *input, float *output, int num_samples)
+{
+    /* block-wise fifo: input and output move in contiguous chunks that end
+       at the next hop boundary, and each frame is transformed once */
+    int n = 0;
+    while (n < num_samples)
+    {
+        int chunk = next_chunk(num_samples - n);
+        
+        write_chunk(input + n, chunk);
+        read_chunk(output + n, chunk);
+        
+        // at a hop boundary, transform and overlap-add after the chunk
+        if (hop_reached(chunk))
         {
-            spectral_processing(fr);
+            spectral_processing();
+            overlap_add(acc_pos);
         }
+        
+        n += chunk;
     }
 }
 
-void PhaseVocodeur3::advance()
+void PhaseVocodeur3::process_pair(PhaseVocodeur3 &other,
+                                  const float *input_a, const float *input_b,
+                                  float *output_a, float *output_b, int num_samples)
 {
-    for (int fr = 0; fr < rw.size(); fr++)
+    /* this instance takes channel a, other takes channel b */
+    if (!is_pair_compatible(other))
+    {
+        process(input_a, output_a, num_samples);
+        other.process(input_b, output_b, num_samples);
+        return;
+    }
+    
+    int n = 0;
+    while (n < num_samples)
     {
-        rw[fr] = (rw[fr] + 1) % ola_size;
+        int chunk = std::min(next_chunk(num_samples - n), other.next_chunk(num_samples - n));
+        
+        write_chunk(input_a + n, chunk);
+        other.write_chunk(input_b + n, chunk);
+        read_chunk(output_a + n, chunk);
+        other.read_chunk(output_b + n, chunk);
+        
+        // both share the hop schedule
+        bool hop = hop_reached(chunk);
+        other.hop_reached(chunk);
+        if (hop)
+        {
+            spectral_processing_pair(other);
+            overlap_add(acc_pos);
+            other.overlap_add(other.acc_pos);
+        }
+        
+        n += chunk;
     }
 }
 
-float PhaseVocodeur3::read_sum()
+void PhaseVocodeur3::process_batch(BatchFFT &batch, PhaseVocodeur3 *const *engines,
+                                   const float *const *input, float *const *output,
+                                   int count, int num_samples)
+{
+    jassert (count <= BatchFFT::max_batch);
+    
+    bool compatible = count > 0 && batch.get_n_fft() == engines[0]->n_fft;
+    for (int i = 1; i < count && compatible; i++)
+    {
+        compatible = engines[0]->is_pair_compatible(*engines[i]);
+    }
+    if (!compatible)
+    {
+        for (int i = 0; i < count; i++)
+            engines[i]->process(input[i], output[i], num_samples);
+        return;
+    }
+    
+    int n = 0;
+    while (n < num_samples)
+    {
+        // all share the hop schedule, so the first engine's chunk fits all
+        int chunk = engines[0]->next_chunk(num_samples - n);
+        
+        bool hop = false;
+        for (int i = 0; i < count; i++)
+        {
+            engines[i]->write_chunk(input[i] + n, chunk);
+            engines[i]->read_chunk(output[i] + n, chunk);
+            hop = engines[i]->hop_reached(chunk);
+        }
+        if (hop)
+        {
+            spectral_processing_batch(batch, engines, count);
+            for (int i = 0; i < count; i++)
+                engines[i]->overlap_add(engines[i]->acc_pos);
+        }
+        
+        n += chunk;
+    }
+}
+
+int PhaseVocodeur3::next_chunk(int remaining)
+{
+    /* samples until the next hop, or until either ring wraps */
+    int chunk = std::min(remaining, samples_to_hop);
+    chunk = std::min(chunk, ola_size - history_pos);
+    chunk = std::min(chunk, acc_size - acc_pos);
+    return chunk;
+}
+
+void PhaseVocodeur3::write_chunk(const float *input, int chunk)
+{
+    /* write input once to the history ring */
+    std::copy(input, input + chunk, input_history.begin() + history_pos);
+    history_pos = (history_pos + chunk) % ola_size;
+}
+
+void PhaseVocodeur3::read_chunk(float *output, int chunk)
+{
+    /* read and consume output */
+    auto acc = output_accumulator.begin() + acc_pos;
+    std::copy(acc, acc + chunk, output);
+    std::fill(acc, acc + chunk, 0.0f);
+    acc_pos = (acc_pos + chunk) % acc_size;
+}
+
+bool PhaseVocodeur3::hop_reached(int chunk)
 {
-    /* overlap-add */
-    float s = 0.0f;
-    for (int fr = 0; fr < num_ola_frames; fr++)
+    samples_to_hop -= chunk;
+    if (samples_to_hop == 0)
     {
-        s += ola_out(fr)(rw[fr]);
+        samples_to_hop = hop_size;
+        return true;
     }
-    s /= 0.5f * (static_cast<float>(frame_size) / static_cast<float>(hop_size));
-    return s;
+    return false;
+}
+
+bool PhaseVocodeur3::is_pair_compatible(PhaseVocodeur3 &other)
+{
+    return other.ola_size == ola_size && other.n_fft == n_fft && other.hop_size == hop_size
+        && other.history_pos == history_pos && other.acc_pos == acc_pos
+        && other.samples_to_hop == samples_to_hop;
+}
+
+void PhaseVocodeur3::overlap_add(int start)
+{
+    if (has_fixed_windows())
+    {
+        fixed_vocodeur->overlap_add(&output_accumulator(0), start, &frame(0));
+        return;
+    }
+    
+    /* add frame * synthesis window into the accumulator from start */
+    int offset = windows->synthesis_offset;
+    float *acc = &output_accumulator(0);
+    const float *f = &frame(offset);
+    const float *sw = &windows->synthesis(offset);
+    int len = ola_size - offset;
+    
+    int first = std::min(len, acc_size - start);          // samples before the ring wraps
+    for (int n = 0; n < first; n++)
+    {
+        acc[start + n] += f[n] * sw[n];
+    }
+    for (int n = first; n < len; n++)
+    {
+        acc[n - first] += f[n] * sw[n];
+    }
+}
+
+void PhaseVocodeur3::forward_fft(const float *time_in, std::complex<float> *spectrum_out)
+{
+    if (fixed_vocodeur)
+        fixed_vocodeur->forward(time_in, spectrum_out);
+    else
+        fft->forward(time_in, spectrum_out);
+}
+
+void PhaseVocodeur3::inverse_fft(const std::complex<float> *spectrum_in, float *time_out, const float *window)
+{
+    if (fixed_vocodeur)
+        fixed_vocodeur->inverse(spectrum_in, time_out, window);
+    else
+        fft->inverse(spectrum_in, time_out, 1.0f, window);
 }
 
 //============ Spectral Processing Methods ======================================
 
-void PhaseVocodeur3::spectral_processing(int fr)
+void PhaseVocodeur3::spectral_processing()
 {
-    // copy current frame
-    ola_out(fr) = ola_in(fr);
-    // apply window
-    ola_out(fr) = bst::element_prod(ola_out(fr), window);
-    // fft
-    bst::vector<std::complex<float> > spectrum = jv_bst::fft(ola_out(fr), fft_forward);
+    RT_GUARD_SCOPE("PhaseVocodeur3::spectral_processing");
+    
+    if (needs_analysis())
+    {
+        // gather current frame and apply window
+        gather_frame(&frame(0));
+        // fft (half-spectrum)
+        forward_fft(&frame(0), &spectrum(0));
+    }
     
-    // ifft
-    spectrum = jv_bst::fft(spectrum, fft_inverse);
-    // store
-    ola_out(fr) = jv_bst::real(spectrum); 
+    // ifft and store
+    if (modify_spectrum())
+    {
+        inverse_fft(&spectrum(0), &frame(0), get_resynthesis_window());
+    }
+}
+
+void PhaseVocodeur3::spectral_processing_pair(PhaseVocodeur3 &other)
+{
+    /* as spectral_processing, with one complex fft each way for both */
+    RT_GUARD_SCOPE("PhaseVocodeur3::spectral_processing_pair");
+    
+    bool analyse = needs_analysis();
+    bool other_analyse = other.needs_analysis();
+    
+    if (analyse)
+        gather_frame(&frame(0));
+    if (other_analyse)
+        other.gather_frame(&other.frame(0));
+    
+    // two fixed vocodeur ffts are cheaper than one shared complex fft
+    bool share_fft = !fixed_vocodeur;
+    
+    if (analyse && other_analyse && share_fft)
+    {
+        fft->forward_pair(&frame(0), &other.frame(0), &spectrum(0), &other.spectrum(0));
+    }
+    else
+    {
+        if (analyse)
+            forward_fft(&frame(0), &spectrum(0));
+        if (other_analyse)
+            other.forward_fft(&other.frame(0), &other.spectrum(0));
+    }
+    
+    bool resynthesise = modify_spectrum();
+    bool other_resynthesise = other.modify_spectrum();
+    
+    if (resynthesise && other_resynthesise && share_fft)
+    {
+        fft->inverse_pair(&spectrum(0), &other.spectrum(0), &frame(0), &other.frame(0),
+                          get_resynthesis_window(), other.get_resynthesis_window());
+    }
+    else
+    {
+        if (resynthesise)
+            inverse_fft(&spectrum(0), &frame(0), get_resynthesis_window());
+        if (other_resynthesise)
+            other.inverse_fft(&other.spectrum(0), &other.frame(0), other.get_resynthesis_window());
+    }
+}
+
+void PhaseVocodeur3::spectral_processing_batch(BatchFFT &batch, PhaseVocodeur3 *const *engines, int count)
+{
+    /* as spectral_processing, with one four-wide fft each way for all */
+    RT_GUARD_SCOPE("PhaseVocodeur3::spectral_processing_batch");
+    
+    const float *time_in[BatchFFT::max_batch];
+    std::complex<float> *spectrum_out[BatchFFT::max_batch];
+    int num_analysed = 0;
+    
+    for (int i = 0; i < count; i++)
+    {
+        PhaseVocodeur3 &e = *engines[i];
+        if (e.needs_analysis())
+        {
+            e.gather_frame(&e.frame(0));
+            time_in[num_analysed] = &e.frame(0);
+            spectrum_out[num_analysed] = &e.spectrum(0);
+            num_analysed++;
+        }
+    }
+    // a lone frame, or frames with a fixed vocodeur, are cheaper through
+    // their own real fft
+    bool share_fft = !engines[0]->fixed_vocodeur;
+    if (num_analysed > 1 && share_fft)
+        batch.forward(time_in, spectrum_out, num_analysed);
+    else
+        for (int i = 0; i < num_analysed; i++)
+            engines[0]->forward_fft(time_in[i], spectrum_out[i]);
+    
+    const std::complex<float> *spectrum_in[BatchFFT::max_batch];
+    float *time_out[BatchFFT::max_batch];
+    const float *windows[BatchFFT::max_batch];
+    int num_resynthesised = 0;
+    
+    for (int i = 0; i < count; i++)
+    {
+        PhaseVocodeur3 &e = *engines[i];
+        if (e.modify_spectrum())
+        {
+            spectrum_in[num_resynthesised] = &e.spectrum(0);
+            time_out[num_resynthesised] = &e.frame(0);
+            windows[num_resynthesised] = e.get_resynthesis_window();
+            num_resynthesised++;
+        }
+    }
+    if (num_resynthesised > 1 && share_fft)
+        batch.inverse(spectrum_in, time_out, num_resynthesised, windows);
+    else
+        for (int i = 0; i < num_resynthesised; i++)
+            engines[0]->inverse_fft(spectrum_in[i], time_out[i], windows[i]);
+}
+
+bool PhaseVocodeur3::needs_analysis()
+{
+    return true;
+}
+
+bool PhaseVocodeur3::modify_spectrum()
+{
+    // identity: resynthesize the analysis spectrum
+    return true;
+}
+
+const float* PhaseVocodeur3::get_resynthesis_window()
+{
+    return nullptr;
+}
+
+void PhaseVocodeur3::gather_frame(float *w)
+{
+    if (has_fixed_windows())
+    {
+        fixed_vocodeur->gather_frame(&input_history(0), history_pos, w);
+        return;
+    }
+    
+    /* copy the last ola_size input samples, oldest first, and apply window */
+    int first = ola_size - history_pos;     // samples before the ring wraps
+    auto r = input_history.begin();
+    const float *h = &(*windows->analysis)(0);
+    
+    for (int n = 0; n < first; n++)
+    {
+        w[n] = r[history_pos + n] * h[n];
+    }
+    for (int n = first; n < ola_size; n++)
+    {
+        w[n] = r[n - first] * h[n];
+    }
 }
 
 //============ Getters ============================================================
@@ -121,6 +444,30 @@ int PhaseVocodeur3::get_num_ola_frames()
 {
     return num_ola_frames;
 }
+bool PhaseVocodeur3::is_fixed_vocodeur_active()
+{
+    return fixed_vocodeur != nullptr;
+}
+bool PhaseVocodeur3::is_low_latency_active()
+{
+    return use_low_latency && 2 * hop_size <= frame_size;
+}
+plan_cache::WindowType PhaseVocodeur3::get_window_type()
+{
+    return window_type;
+}
+int PhaseVocodeur3::get_latency_samples()
+{
+    // a frame holds the last ola_size inputs and is overlap-added from the
+    // next output sample, so every input sample comes out ola_size later,
+    // less the frame samples skipped before the overlap-added part
+    return ola_size - windows->synthesis_offset;
+}
+int PhaseVocodeur3::get_tail_samples()
+{
+    // the last frame holding the last input sample ends ola_size after it
+    return get_latency_samples() + ola_size;
+}
 
 //============ Setters ============================================================
 
@@ -128,11 +475,14 @@ void PhaseVocodeur3::set_frame_size(int frame_size)
 {
     this->frame_size = frame_size;
     init_window();
+    init_fixed_vocodeur();
 }
 void PhaseVocodeur3::set_hop_size(int hop_size)
 {
     this->hop_size = hop_size;
     init_ola();
+    init_window();
+    init_fixed_vocodeur();
 }
 void PhaseVocodeur3::set_n_fft(int n_fft)
 {
@@ -143,48 +493,111 @@ void PhaseVocodeur3::set_n_fft(int n_fft)
     this->ola_size = n_fft;
     init_fft();
     init_ola();
+    init_window();
+    init_fixed_vocodeur();
 }
 void PhaseVocodeur3::set_ola_size(int ola_size)
 {
     this->ola_size = ola_size;
     init_ola();
+    init_window();
+    init_fixed_vocodeur();
+}
+void PhaseVocodeur3::set_use_fixed_vocodeur(bool use_fixed_vocodeur)
+{
+    this->use_fixed_vocodeur = use_fixed_vocodeur;
+    init_fixed_vocodeur();
+}
+void PhaseVocodeur3::set_low_latency(bool use_low_latency)
+{
+    this->use_low_latency = use_low_latency;
+    // the latency changes, so start over
+    init_ola();
+    init_window();
+}
+void PhaseVocodeur3::set_window_type(plan_cache::WindowType window_type)
+{
+    int index = static_cast<int>(window_type);
+    if (index < 0 || index >= plan_cache::num_analysis_types)
+        return;
+    
+    this->window_type = window_type;
+    windows = window_sets[index].get();
+}
+
+void PhaseVocodeur3::begin_warm_up(PhaseVocodeur3 &previous)
+{
+    set_window_type(previous.window_type);
+}
+void PhaseVocodeur3::end_warm_up()
+{
+    
+}
+bool PhaseVocodeur3::depends_on_input()
+{
+    return needs_analysis();
 }
 
 //============ Initialization =====================================================
 
 void PhaseVocodeur3::init_fft()
 {
-    fft_forward = kiss_fft_alloc(n_fft, 0, 0, 0);
-    fft_inverse = kiss_fft_alloc(n_fft, 1, 0, 0);
+    fft.reset(new RealFFT(n_fft));
+    num_bins = fft->get_num_bins();
+    spectrum = aligned_vector<std::complex<float> > (num_bins, 0.0f);
 }
 
 void PhaseVocodeur3::init_ola()
 {
-    /* Initialize Overlap-Add (OLA) containers and rw positions */
+    /* Initialize Overlap-Add (OLA) containers and positions */
     
-    // assign number of frames based on overlap
+    // number of frames overlapping each output sample
     num_ola_frames = ceil(static_cast<float>(ola_size) / static_cast<float>(hop_size));
     
-    // allocate ola in/out frames
-    ola_in  = bst::vector<bst::vector<float> > (num_ola_frames, bst::vector<float>(ola_size, 0.0));
-    ola_out = bst::vector<bst::vector<float> > (num_ola_frames, bst::vector<float>(ola_size, 0.0));
-    
+    // input history ring and current frame
+    input_history = bst::vector<float> (ola_size, 0.0);
+    history_pos = 0;
+    frame = bst::vector<float> (ola_size, 0.0);
     
-    // initialize rw positions
-    int pos = 0;
-    rw.clear();
-    for (int i = 0; i < num_ola_frames; i++)
-    {
-        rw.push_back(pos);
-        pos = (pos + hop_size) % ola_size;
-    }
+    // output accumulator: the sample being read plus one frame ahead of it
+    acc_size = ola_size + hop_size;
+    output_accumulator = bst::vector<float> (acc_size, 0.0);
+    acc_pos = 0;
     
+    // first frame is full after ola_size samples, modulo the hop
+    samples_to_hop = (ola_size - 1) % hop_size + 1;
 }
 
 void PhaseVocodeur3::init_window()
 {
-    window = hann(frame_size);
-    window = jv_bst::zp(window, ola_size - frame_size);
+    /* fetch every window set set_window_type may switch to, so switching
+       never builds one on the audio thread */
+    if (is_low_latency_active())
+    {
+        // hann of length 2 hop_size at the end of the frame, whatever the type
+        auto set = plan_cache::get_overlap_add_windows(plan_cache::WindowType::asymmetric_analysis, frame_size, ola_size, hop_size);
+        for (auto &s : window_sets)
+            s = set;
+    }
+    else
+    {
+        for (int i = 0; i < plan_cache::num_analysis_types; i++)
+            window_sets[i] = plan_cache::get_overlap_add_windows(static_cast<plan_cache::WindowType>(i), frame_size, ola_size, hop_size);
+    }
+    windows = window_sets[static_cast<int>(window_type)].get();
 }
 
+bool PhaseVocodeur3::has_fixed_windows()
+{
+    return fixed_vocodeur && !is_low_latency_active() && window_type == plan_cache::WindowType::hann;
+}
 
+void PhaseVocodeur3::init_fixed_vocodeur()
+{
+    /* compile-time specialization for preset geometries (only its ffts
+       with other windows) */
+    if (use_fixed_vocodeur)
+        fixed_vocodeur = make_fixed_vocodeur(frame_size, hop_size, n_fft, ola_size);
+    else
+        fixed_vocodeur.reset();
+}
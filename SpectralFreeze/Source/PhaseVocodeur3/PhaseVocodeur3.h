@@ -8,17 +8,33 @@
     Phase Vocodeur (Vocoder) implementation using Boost for containers and
     kiss_fft for FFT.
  
-    CURRENT ISSUES:
-    *   frame_size, n_fft and hop_size must be powers of 2 to get perfect
-        reconstruction. 
+    Low latency (set_low_latency): an asymmetric analysis window over the
+    frame, and a synthesis window over only its last 2 hop_size samples,
+    whose product is a hann of that length. Only that part of each frame is
+    overlap-added, so the output is ola_size - frame_size + 2 hop_size
+    behind the input instead of ola_size, while the spectrum still has the
+    resolution of the whole frame. Needs frame_size >= 2 hop_size.
+ 
+    Overlap-add gain: the synthesis window is divided by what the analysis
+    times synthesis windows of overlapping frames sum to at each sample
+    (cola_normalize), so every frame_size / hop_size / n_fft and window
+    pair reconstructs with unity gain.
+ 
+    Analysis window (set_window_type): hann, hamming, blackman-harris or
+    kaiser with a rectangular synthesis window, or sqrt-hann on both sides
+    (weighted overlap-add). The tables for all of them come from
+    plan_cache when the engine is initialized, so switching only swaps a
+    pointer and is safe from the audio thread.
  
   ==============================================================================
 */
 
 #pragma once
 
+#include <algorithm>
 #include <complex>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
@@ -27,12 +43,18 @@
 
 #include <kiss_fft/kiss_fft.h>
 #include <kiss_fft/_kiss_fft_guts.h>
+#include <kiss_fft/tools/kiss_fftr.h>
 //#include "../kiss_fft/kiss_fft.h"
 //#include "../kiss_fft/_kiss_fft_guts.h"
 
 
 #include <JuceHeader.h>
 
+#include "../BatchFFT/BatchFFT.h"
+#include "../FixedVocodeur/FixedVocodeur.h"
+#include "../PlanCache/PlanCache.h"
+#include "../RealFFT/RealFFT.h"
+#include "../RealtimeGuard/RealtimeGuard.h"
 #include "../VectorOperations2/VectorOperations2.h"
 #include "../Windows/Windows.h"
 
@@ -52,8 +74,31 @@ public:
     virtual void advance();
     float read_sum();
     
-    /* spectral processing */
-    virtual void spectral_processing(int fr);
+    /* block operation: equivalent to push(), read_sum(), advance() per sample.
+       input and output may point to the same buffer. */
+    virtual void process(const float *input, float *output, int num_samples);
+    /* stereo block operation: this instance processes channel a, other
+       channel b, sharing one complex fft per hop in each direction. Falls
+       back to two process() calls unless both have the same geometry. On a
+       FixedVocodeur (preset geometries) each keeps its own real fft, which
+       is cheaper than the shared one, so this only saves work at other
+       geometries. */
+    void process_pair(PhaseVocodeur3 &other,
+                      const float *input_a, const float *input_b,
+                      float *output_a, float *output_b, int num_samples);
+    /* multichannel block operation: engines[i] processes input[i] into
+       output[i], up to BatchFFT::max_batch engines sharing one four-wide fft
+       per hop in each direction. Falls back to process() per engine unless
+       all have the same geometry as each other and as batch. Like
+       process_pair, only shares ffts when not on a FixedVocodeur. */
+    static void process_batch(BatchFFT &batch, PhaseVocodeur3 *const *engines,
+                              const float *const *input, float *const *output,
+                              int count, int num_samples);
+    
+    /* spectral processing: turns the gathered frame into an output frame */
+    virtual void spectral_processing();
+    void spectral_processing_pair(PhaseVocodeur3 &other);
+    static void spectral_processing_batch(BatchFFT &batch, PhaseVocodeur3 *const *engines, int count);
     
     /* getters */
     int get_frame_size();
@@ -61,12 +106,39 @@ public:
     int get_n_fft();
     int get_ola_size();
     int get_num_ola_frames();
+    bool is_fixed_vocodeur_active();
+    bool is_low_latency_active();
+    plan_cache::WindowType get_window_type();
+    /* an input sample is heard ola_size samples later (less in low
+       latency), whatever the block size; a modified frame overlap-adds for
+       up to ola_size more */
+    int get_latency_samples();
+    int get_tail_samples();
     
-    /* setters */
+    /* setters: these reallocate and restart the engine, so not from the
+       audio thread (GeometrySwitcher changes geometry while running) */
     void virtual set_frame_size(int frame_size);
     void virtual set_hop_size(int hop_size);
     void virtual set_n_fft(int n_fft);
     void virtual set_ola_size(int ola_size);
+    /* true (default): preset geometries run on a FixedVocodeur */
+    void set_use_fixed_vocodeur(bool use_fixed_vocodeur);
+    /* false (default): symmetric hann analysis, latency ola_size. true:
+       asymmetric windows, if frame_size >= 2 hop_size */
+    void set_low_latency(bool use_low_latency);
+    /* analysis window, one of the first plan_cache::num_analysis_types
+       (default hann; low latency keeps its asymmetric pair). Doesn't
+       allocate: fine from the audio thread. */
+    void set_window_type(plan_cache::WindowType window_type);
+    
+    /* geometry changes (GeometrySwitcher): an engine replacing previous
+       takes over its settings (here the window type) in begin_warm_up,
+       analyses until its output is complete and is faded in after
+       end_warm_up. Subclasses with settings hide these with their own. */
+    void begin_warm_up(PhaseVocodeur3 &previous);
+    void end_warm_up();
+    /* false while the output doesn't depend on the input */
+    bool depends_on_input();
     
     
 protected:
@@ -77,22 +149,67 @@ protected:
     int ola_size            {1024};
     
     int num_ola_frames      {2};
+    int num_bins            {513};
     
-    /* fft plans */
-    kiss_fft_cfg fft_forward;
-    kiss_fft_cfg fft_inverse;
+    /* real fft (n_fft real <-> num_bins complex), out of place */
+    std::unique_ptr<RealFFT> fft;
+    /* compile-time sized gather, ffts and overlap-add for preset
+       geometries, only its ffts in low latency (nullptr: runtime loops and
+       fft) */
+    std::unique_ptr<FixedVocodeurBase> fixed_vocodeur;
+    bool use_fixed_vocodeur {true};
+    bool use_low_latency {false};
+    aligned_vector<std::complex<float> > spectrum;
     
     /* time domain containers */
-    bst::vector<bst::vector<float> > ola_in, ola_out;
-    bst::vector<float> window;
+    bst::vector<float> input_history;               // ring of the last ola_size inputs
+    bst::vector<float> frame;                       // current analysis/synthesis frame
+    bst::vector<float> output_accumulator;          // ring of overlap-added output
+    
+    /* shared windows for each analysis type (all the asymmetric pair in low
+       latency), and the ones in use */
+    std::shared_ptr<const plan_cache::OverlapAddWindows> window_sets[plan_cache::num_analysis_types];
+    const plan_cache::OverlapAddWindows *windows {nullptr};
+    plan_cache::WindowType window_type {plan_cache::WindowType::hann};
     
     /* read/write buffer positions */
-    std::vector<int> rw;
+    int history_pos         {0};                    // next write into input_history
+    int acc_pos             {0};                    // current read from output_accumulator
+    int acc_size            {1152};
+    int samples_to_hop      {128};                  // input samples until the next frame
+    
+    /* spectral processing stages, override these to process spectra:
+       needs_analysis:          false skips gathering and the forward fft
+       modify_spectrum:         edit spectrum in place; return true to resynthesize
+                                it into frame, false to output frame unchanged
+       get_resynthesis_window:  window applied by the inverse fft (nullptr: none) */
+    virtual bool needs_analysis();
+    virtual bool modify_spectrum();
+    virtual const float* get_resynthesis_window();
+    
+    /* block fifo helpers */
+    int next_chunk(int remaining);
+    void write_chunk(const float *input, int chunk);
+    void read_chunk(float *output, int chunk);
+    bool hop_reached(int chunk);
+    bool is_pair_compatible(PhaseVocodeur3 &other);
+    
+    /* writes the current windowed analysis frame (ola_size samples) to w */
+    void gather_frame(float *w);
+    /* adds frame * the synthesis window, from its synthesis_offset, into
+       output_accumulator from start */
+    void overlap_add(int start);
+    /* true if fixed_vocodeur's hann windows are the ones in use */
+    bool has_fixed_windows();
+    /* single frame ffts, through fixed_vocodeur when there is one */
+    void forward_fft(const float *time_in, std::complex<float> *spectrum_out);
+    void inverse_fft(const std::complex<float> *spectrum_in, float *time_out, const float *window);
 
     /* initialization */
     void init_fft();
     void init_ola();
     void init_window();
+    void init_fixed_vocodeur();
     
 private:
 
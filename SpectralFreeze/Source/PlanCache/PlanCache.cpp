@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    PlanCache.cpp
+    Created: 17 Oct 2026 5:33:01am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "PlanCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include <kiss_fft/kiss_fft.h>
+
+#include "../Windows/Windows.h"
+
+namespace plan_cache
+{
+    namespace
+    {
+        typedef std::vector<std::complex<float> > Twiddles;
+
+        /* function-local, so they are built before any engine asks for them */
+        SharedCache<std::pair<int, bool>, kiss_fft_state>& fft_plans()
+        {
+            static SharedCache<std::pair<int, bool>, kiss_fft_state> cache;
+            return cache;
+        }
+        SharedCache<int, const Twiddles>& split_twiddles()
+        {
+            static SharedCache<int, const Twiddles> cache;
+            return cache;
+        }
+        SharedCache<std::tuple<WindowType, int, int, int>, const aligned_vector<float> >& windows()
+        {
+            static SharedCache<std::tuple<WindowType, int, int, int>, const aligned_vector<float> > cache;
+            return cache;
+        }
+        SharedCache<std::tuple<WindowType, int, int, int>, const OverlapAddWindows>& overlap_add_windows()
+        {
+            static SharedCache<std::tuple<WindowType, int, int, int>, const OverlapAddWindows> cache;
+            return cache;
+        }
+    }
+
+    std::shared_ptr<kiss_fft_state> get_fft_plan(int n_fft, bool inverse)
+    {
+        return fft_plans().get(std::make_pair(n_fft, inverse), [n_fft, inverse] ()
+        {
+            kiss_fft_cfg plan = kiss_fft_alloc(n_fft, inverse ? 1 : 0, 0, 0);
+            if (plan == nullptr)
+                throw std::bad_alloc();
+            return std::shared_ptr<kiss_fft_state> (plan, [] (kiss_fft_cfg p) { kiss_fft_free(p); });
+        });
+    }
+
+    std::shared_ptr<const std::vector<std::complex<float> > > get_split_twiddles(int n_fft)
+    {
+        return split_twiddles().get(n_fft, [n_fft] ()
+        {
+            Twiddles *twiddles = new Twiddles (n_fft/2 + 1);
+            for (int k = 0; k <= n_fft/2; k++)
+            {
+                double phase = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n_fft);
+                (*twiddles)[k] = std::complex<float> (static_cast<float>(std::cos(phase)),
+                                                      static_cast<float>(std::sin(phase)));
+            }
+            return std::shared_ptr<const Twiddles> (twiddles);
+        });
+    }
+
+    std::shared_ptr<const aligned_vector<float> > get_window(WindowType type, int len, int size, int synthesis_len)
+    {
+        bool is_asymmetric = (type == WindowType::asymmetric_analysis || type == WindowType::asymmetric_synthesis);
+        if (!is_asymmetric)
+            synthesis_len = 0;
+        
+        return windows().get(std::make_tuple(type, len, size, synthesis_len), [type, len, size, synthesis_len] ()
+        {
+            // window straight into the zero-padded table
+            aligned_vector<float> *window = new aligned_vector<float> (size, 0.0f);
+            float *w = &(*window)(0);
+            switch (type)
+            {
+                case WindowType::hann:              hann(w, len);                   break;
+                case WindowType::hamming:           hamming(w, len);                break;
+                case WindowType::blackman_harris:   blackman_harris(w, len);        break;
+                case WindowType::kaiser:            kaiser(w, len, kaiser_beta);    break;
+                case WindowType::sqrt_hann:         sqrt_hann(w, len);              break;
+                case WindowType::asymmetric_analysis:
+                    asymmetric_analysis(w, len, synthesis_len);
+                    break;
+                case WindowType::asymmetric_synthesis:
+                    asymmetric_synthesis(w, len, synthesis_len);
+                    break;
+            }
+            return std::shared_ptr<const aligned_vector<float> > (window);
+        });
+    }
+
+    std::shared_ptr<const OverlapAddWindows> get_overlap_add_windows(WindowType analysis, int frame_size, int ola_size, int hop_size)
+    {
+        return overlap_add_windows().get(std::make_tuple(analysis, frame_size, ola_size, hop_size), [analysis, frame_size, ola_size, hop_size] ()
+        {
+            OverlapAddWindows *windows = new OverlapAddWindows ();
+            windows->analysis = get_window(analysis, frame_size, ola_size, 2 * hop_size);
+            windows->synthesis_offset = 0;
+            
+            const float *a = &(*windows->analysis)(0);
+            aligned_vector<float> &synthesis = windows->synthesis;
+            aligned_vector<float> &resynthesis = windows->resynthesis;
+            synthesis = aligned_vector<float> (ola_size, 1.0f);
+            
+            if (analysis == WindowType::sqrt_hann || analysis == WindowType::asymmetric_analysis)
+            {
+                // weighted overlap-add: the synthesis window tapers the frame
+                if (analysis == WindowType::sqrt_hann)
+                {
+                    sqrt_hann(&synthesis(0), frame_size);
+                }
+                else
+                {
+                    asymmetric_synthesis(&synthesis(0), frame_size, 2 * hop_size);
+                    windows->synthesis_offset = frame_size - 2 * hop_size;
+                }
+                std::fill(synthesis.begin() + frame_size, synthesis.end(), 0.0f);
+                cola_normalize(a, &synthesis(0), ola_size, hop_size, &synthesis(0));
+                
+                // a modified frame already has the analysis taper, which
+                // synthesis completes
+                resynthesis = aligned_vector<float> (ola_size, 1.0f);
+            }
+            else
+            {
+                cola_normalize(a, &synthesis(0), ola_size, hop_size, &synthesis(0));
+                
+                // a modified frame gets the analysis taper again, with the
+                // gain that makes it overlap-add to 1 through synthesis too
+                aligned_vector<float> product = bst::element_prod(*windows->analysis, synthesis);
+                resynthesis = aligned_vector<float> (ola_size);
+                cola_normalize(&product(0), a, ola_size, hop_size, &resynthesis(0));
+            }
+            return std::shared_ptr<const OverlapAddWindows> (windows);
+        });
+    }
+
+    int get_num_entries()
+    {
+        return fft_plans().get_num_entries()
+             + split_twiddles().get_num_entries()
+             + windows().get_num_entries()
+             + overlap_add_windows().get_num_entries();
+    }
+}
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    PlanCache.h
+    Created: 17 Oct 2026 5:33:01am
+    Author:  agent
+
+        Process-wide cache of immutable fft plans and window tables.
+
+    Every engine used to allocate its own kiss plans and compute its own
+    Hann window, so a session with many instances repeated the same work
+    and held the same tables many times over. The getters here return a
+    shared_ptr to a table keyed by its size (and type), building it on the
+    first request and handing the same one to every later request:
+
+        get_fft_plan        complex kiss_fft plan of length n_fft
+        get_split_twiddles  exp(-2 pi i k / n_fft), k in [0, n_fft/2], for
+                            separating real transforms out of complex ones
+        get_window          analysis (or synthesis) window, zero-padded
+        get_overlap_add_windows
+                            the analysis, synthesis and resynthesis windows
+                            of one overlap-add geometry
+
+    Windows are built once per type and size, in 64-byte aligned storage,
+    so an engine can hold the tables for every type it may switch to and
+    switch by swapping a pointer, without allocating or computing a window
+    on the audio thread.
+
+    The cache only holds weak references, so a table is freed when the
+    last engine using it lets go, and built again if it's asked for later.
+    Lookups lock a mutex and may allocate: call them when an engine is
+    constructed or reconfigured, never from the audio thread.
+
+    Everything handed out is read-only once built. kiss_fft only reads its
+    plan for out-of-place transforms, so a plan can be used from several
+    threads at once; in-place transforms would write its temporary buffer
+    and must not go through a shared plan.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+namespace bst = boost::numeric::ublas;
+
+/* ublas vector with 64-byte aligned storage */
+template <typename T>
+using aligned_vector = bst::vector<T, bst::unbounded_array<T, boost::alignment::aligned_allocator<T, 64> > >;
+
+/* kiss_fft_cfg is a pointer to this */
+struct kiss_fft_state;
+
+namespace plan_cache
+{
+    /* the first num_analysis_types can be picked as an engine's analysis
+       window; the asymmetric pair is what low latency mode uses */
+    enum class WindowType
+    {
+        hann,
+        hamming,
+        blackman_harris,
+        kaiser,
+        sqrt_hann,
+        asymmetric_analysis,
+        asymmetric_synthesis
+    };
+    constexpr int num_analysis_types = 5;
+    
+    /* shape of WindowType::kaiser */
+    constexpr double kaiser_beta = 8.0;
+    
+    /* the windows of one overlap-add geometry, each ola_size long */
+    struct OverlapAddWindows
+    {
+        /* times the input frame, before the forward fft */
+        std::shared_ptr<const aligned_vector<float> > analysis;
+        /* times the output frame as it is overlap-added, normalized so
+           unmodified frames add back up to the input */
+        aligned_vector<float> synthesis;
+        /* times a frame resynthesized from a modified spectrum, which has
+           roughly the analysis taper: the analysis window again if synthesis
+           is rectangular, ones if synthesis tapers, normalized so the frames
+           overlap-add to 1 */
+        aligned_vector<float> resynthesis;
+        /* synthesis is zero before this sample */
+        int synthesis_offset;
+    };
+
+    /* forward (inverse false) or inverse complex plan of length n_fft */
+    std::shared_ptr<kiss_fft_state> get_fft_plan(int n_fft, bool inverse);
+    /* n_fft/2 + 1 factors exp(-2 pi i k / n_fft), n_fft even */
+    std::shared_ptr<const std::vector<std::complex<float> > > get_split_twiddles(int n_fft);
+    /* window of length len followed by size - len zeros; synthesis_len is
+       that of the asymmetric pair, and ignored by the other types */
+    std::shared_ptr<const aligned_vector<float> > get_window(WindowType type, int len, int size, int synthesis_len = 0);
+    /* windows for frames of frame_size, zero-padded to ola_size, every
+       hop_size samples. analysis is one of the first num_analysis_types,
+       with a rectangular synthesis window or, for sqrt_hann, a sqrt_hann
+       one; or asymmetric_analysis, with the asymmetric synthesis window
+       over the last 2 * hop_size samples of the frame */
+    std::shared_ptr<const OverlapAddWindows> get_overlap_add_windows(WindowType analysis, int frame_size, int ola_size, int hop_size);
+
+    /* number of tables alive in the cache */
+    int get_num_entries();
+
+    /* a map from key to weakly held, shared values */
+    template <class Key, class T>
+    class SharedCache
+    {
+
+    public:
+        /* the live value for key, or a new one from create() */
+        template <class Create>
+        std::shared_ptr<T> get(const Key &key, Create create)
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+
+            std::shared_ptr<T> value = entries[key].lock();
+            if (value == nullptr)
+            {
+                purge();
+                value = create();
+                entries[key] = value;
+            }
+            return value;
+        }
+
+        int get_num_entries()
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+
+            purge();
+            return static_cast<int>(entries.size());
+        }
+
+    private:
+        std::mutex mutex;
+        std::map<Key, std::weak_ptr<T> > entries;
+
+        /* drop entries whose value has been freed */
+        void purge()
+        {
+            for (auto it = entries.begin(); it != entries.end(); )
+            {
+                if (it->second.expired())
+                    it = entries.erase(it);
+                else
+                    ++it;
+            }
+        }
+    };
+}
@@ -28,11 +28,69 @@ SpectralFreezeAudioProcessorEditor::SpectralFreezeAudioProcessorEditor (Spectral
     addAndMakeVisible(freeze_toggle_button);
     freeze_toggle_attachment.reset( new juce::AudioProcessorValueTreeState::ButtonAttachment (state, "freezeToggle", freeze_toggle_button));
     
+    fft_size_box_label.setText("fft size", juce::dontSendNotification);
+    fft_size_box_label.attachToComponent(&fft_size_box, true);
+    addAndMakeVisible(fft_size_box_label);
+    
+    // items before the attachment, which selects the parameter's choice
+    fft_size_box.addItemList(juce::StringArray {"256", "512", "1024", "2048", "4096"}, 1);
+    addAndMakeVisible(fft_size_box);
+    fft_size_attachment.reset( new juce::AudioProcessorValueTreeState::ComboBoxAttachment (state, "fftSize", fft_size_box));
+    
+    low_latency_button_label.setText("low latency", juce::dontSendNotification);
+    low_latency_button_label.attachToComponent(&low_latency_button, true);
+    addAndMakeVisible(low_latency_button_label);
+    
+    addAndMakeVisible(low_latency_button);
+    low_latency_attachment.reset( new juce::AudioProcessorValueTreeState::ButtonAttachment (state, "lowLatency", low_latency_button));
+    
+    window_type_box_label.setText("window", juce::dontSendNotification);
+    window_type_box_label.attachToComponent(&window_type_box, true);
+    addAndMakeVisible(window_type_box_label);
+    
+    window_type_box.addItemList(juce::StringArray {"Hann", "Hamming", "Blackman-Harris", "Kaiser", "sqrt-Hann"}, 1);
+    addAndMakeVisible(window_type_box);
+    window_type_attachment.reset( new juce::AudioProcessorValueTreeState::ComboBoxAttachment (state, "windowType", window_type_box));
+    
+    bank_slot_box_label.setText("slot", juce::dontSendNotification);
+    bank_slot_box_label.attachToComponent(&bank_slot_box, true);
+    addAndMakeVisible(bank_slot_box_label);
+    
+    bank_slot_box.addItemList(juce::StringArray {"1", "2", "3", "4", "5", "6", "7", "8"}, 1);
+    addAndMakeVisible(bank_slot_box);
+    bank_slot_attachment.reset( new juce::AudioProcessorValueTreeState::ComboBoxAttachment (state, "bankSlot", bank_slot_box));
+    
+    capture_button.setButtonText("capture");
+    capture_button.setClickingTogglesState(true);
+    addAndMakeVisible(capture_button);
+    capture_attachment.reset( new juce::AudioProcessorValueTreeState::ButtonAttachment (state, "captureToggle", capture_button));
+    
+    morph_from_box_label.setText("from", juce::dontSendNotification);
+    morph_from_box_label.attachToComponent(&morph_from_box, true);
+    addAndMakeVisible(morph_from_box_label);
+    
+    morph_from_box.addItemList(juce::StringArray {"Live", "1", "2", "3", "4", "5", "6", "7", "8"}, 1);
+    addAndMakeVisible(morph_from_box);
+    morph_from_attachment.reset( new juce::AudioProcessorValueTreeState::ComboBoxAttachment (state, "morphFrom", morph_from_box));
+    
+    morph_to_box_label.setText("to", juce::dontSendNotification);
+    morph_to_box_label.attachToComponent(&morph_to_box, true);
+    addAndMakeVisible(morph_to_box_label);
+    
+    morph_to_box.addItemList(juce::StringArray {"Off", "1", "2", "3", "4", "5", "6", "7", "8"}, 1);
+    addAndMakeVisible(morph_to_box);
+    morph_to_attachment.reset( new juce::AudioProcessorValueTreeState::ComboBoxAttachment (state, "morphTo", morph_to_box));
+    
+    morph_slider.setSliderStyle(juce::Slider::LinearHorizontal);
+    morph_slider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    addAndMakeVisible(morph_slider);
+    morph_attachment.reset( new juce::AudioProcessorValueTreeState::SliderAttachment (state, "morph", morph_slider));
+    
     addAndMakeVisible(bar_graph);
     
     startTimer(100);
     
-    setSize (400, 300);
+    setSize (400, 380);
 }
 
 SpectralFreezeAudioProcessorEditor::~SpectralFreezeAudioProcessorEditor()
@@ -51,16 +109,26 @@ void SpectralFreezeAudioProcessorEditor::resized()
     header_label.setBounds(0, 0, getWidth(), getHeight());
 //    freeze_toggle_button.setBounds(freeze_toggle_button_label.getWidth() + 10, header_label.getY() + header_label.getHeight() + 10, 100, freeze_toggle_button_label.getHeight());
     freeze_toggle_button.setBounds(100, 100, 100, 100);
-    bar_graph.setBounds(10, 200, getWidth()-20, 100);
+    window_type_box.setBounds(290, 100, 90, 30);
+    fft_size_box.setBounds(290, 135, 90, 30);
+    low_latency_button.setBounds(290, 170, 30, 30);
+    bank_slot_box.setBounds(60, 210, 60, 25);
+    capture_button.setBounds(130, 210, 80, 25);
+    morph_from_box.setBounds(60, 240, 70, 25);
+    morph_to_box.setBounds(170, 240, 70, 25);
+    morph_slider.setBounds(250, 240, 140, 25);
+    bar_graph.setBounds(10, 280, getWidth()-20, 100);
 }
 
 void SpectralFreezeAudioProcessorEditor::timerCallback()
 {
-    boost::numeric::ublas::vector<float> magnitude_bst = audioProcessor.get_magnitude();
-    juce::Array<float> magnitude;
-    magnitude.resize(magnitude_bst.size()/2 + 1);
+    // latest hop published by the audio thread, lock-free
+    SpectrumSnapshot& snapshot = audioProcessor.get_magnitude_snapshot();
+    if (!snapshot.update())
+        return;
     
-    std::copy(magnitude_bst.begin(), magnitude_bst.begin() + magnitude.size(), magnitude.begin());
+    magnitude.resize(snapshot.get_size());
+    std::copy(snapshot.get_data(), snapshot.get_data() + snapshot.get_size(), magnitude.begin());
     
     bar_graph.set_data(magnitude);
     bar_graph.repaint();
@@ -39,7 +39,39 @@ private:
     juce::Label freeze_toggle_button_label;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> freeze_toggle_attachment;
     
+    juce::ComboBox fft_size_box;
+    juce::Label fft_size_box_label;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> fft_size_attachment;
+    
+    juce::ToggleButton low_latency_button;
+    juce::Label low_latency_button_label;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> low_latency_attachment;
+    
+    juce::ComboBox window_type_box;
+    juce::Label window_type_box_label;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> window_type_attachment;
+    
+    juce::ComboBox bank_slot_box;
+    juce::Label bank_slot_box_label;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> bank_slot_attachment;
+    
+    /* each click flips the parameter, which captures */
+    juce::TextButton capture_button;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> capture_attachment;
+    
+    juce::ComboBox morph_from_box;
+    juce::Label morph_from_box_label;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> morph_from_attachment;
+    
+    juce::ComboBox morph_to_box;
+    juce::Label morph_to_box_label;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> morph_to_attachment;
+    
+    juce::Slider morph_slider;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> morph_attachment;
+    
     BarGraph bar_graph;
+    juce::Array<float> magnitude;
     
     SpectralFreezeAudioProcessor& audioProcessor;
 
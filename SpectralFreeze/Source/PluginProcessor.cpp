@@ -15,7 +15,36 @@ SpectralFreezeAudioProcessor::SpectralFreezeAudioProcessor()
            {
                std::make_unique<juce::AudioParameterBool>("freezeToggle",
                                                             "Freeze Toggle",
-                                                            false)
+                                                            false),
+               std::make_unique<juce::AudioParameterChoice>("fftSize",
+                                                            "FFT Size",
+                                                            juce::StringArray {"256", "512", "1024", "2048", "4096"},
+                                                            2),
+               std::make_unique<juce::AudioParameterBool>("lowLatency",
+                                                            "Low Latency",
+                                                            false),
+               std::make_unique<juce::AudioParameterChoice>("windowType",
+                                                            "Window",
+                                                            juce::StringArray {"Hann", "Hamming", "Blackman-Harris", "Kaiser", "sqrt-Hann"},
+                                                            0),
+               std::make_unique<juce::AudioParameterChoice>("bankSlot",
+                                                            "Bank Slot",
+                                                            juce::StringArray {"1", "2", "3", "4", "5", "6", "7", "8"},
+                                                            0),
+               std::make_unique<juce::AudioParameterBool>("captureToggle",
+                                                            "Capture",
+                                                            false),
+               std::make_unique<juce::AudioParameterChoice>("morphFrom",
+                                                            "Morph From",
+                                                            juce::StringArray {"Live", "1", "2", "3", "4", "5", "6", "7", "8"},
+                                                            0),
+               std::make_unique<juce::AudioParameterChoice>("morphTo",
+                                                            "Morph To",
+                                                            juce::StringArray {"Off", "1", "2", "3", "4", "5", "6", "7", "8"},
+                                                            0),
+               std::make_unique<juce::AudioParameterFloat>("morph",
+                                                            "Morph",
+                                                            0.0f, 1.0f, 0.0f)
            }),
 #ifndef JucePlugin_PreferredChannelConfigurations
      AudioProcessor (BusesProperties()
@@ -29,10 +58,20 @@ SpectralFreezeAudioProcessor::SpectralFreezeAudioProcessor()
 #endif
 {
     freeze_toggle_parameter = parameters.getRawParameterValue("freezeToggle");
+    fft_size_parameter = parameters.getRawParameterValue("fftSize");
+    low_latency_parameter = parameters.getRawParameterValue("lowLatency");
+    window_type_parameter = parameters.getRawParameterValue("windowType");
+    bank_slot_parameter = parameters.getRawParameterValue("bankSlot");
+    capture_toggle_parameter = parameters.getRawParameterValue("captureToggle");
+    morph_from_parameter = parameters.getRawParameterValue("morphFrom");
+    morph_to_parameter = parameters.getRawParameterValue("morphTo");
+    morph_parameter = parameters.getRawParameterValue("morph");
+    startTimerHz (latency_poll_hz);
 }
 
 SpectralFreezeAudioProcessor::~SpectralFreezeAudioProcessor()
 {
+    stopTimer();
 }
 
 //==============================================================================
@@ -70,7 +109,11 @@ bool SpectralFreezeAudioProcessor::isMidiEffect() const
 
 double SpectralFreezeAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // overlap-add smear after the input stops; a held freeze lasts until released
+    double sample_rate = getSampleRate();
+    if (sample_rate <= 0.0)
+        return 0.0;
+    return tail_samples.load() / sample_rate;
 }
 
 int SpectralFreezeAudioProcessor::getNumPrograms()
@@ -101,12 +144,42 @@ void SpectralFreezeAudioProcessor::changeProgramName (int index, const juce::Str
 void SpectralFreezeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     previous_freeze_toggle = (*freeze_toggle_parameter < 0.5f);
+    
+    // one freezer per channel, so processBlock never allocates
+    int num_channels = juce::jmin (getTotalNumOutputChannels(), max_channels);
+    requested_n_fft = get_n_fft(*fft_size_parameter);
+    requested_low_latency = !(*low_latency_parameter < 0.5f);
+    freezers.reset();
+    
+    // every slot for every channel now, so capturing never allocates
+    if (freeze_bank == nullptr || freeze_bank->get_num_channels() != num_channels)
+        freeze_bank = std::make_unique<FreezeBank> (num_bank_slots, num_channels, max_bank_bins);
+    previous_capture_toggle = !(*capture_toggle_parameter < 0.5f);
+    
+    freezers = std::make_unique<GeometrySwitcher<JVFreezer> > (num_channels,
+        GeometrySwitcher<JVFreezer>::Geometry {requested_n_fft, requested_n_fft/4, requested_n_fft, requested_low_latency});
+    if (num_channels > 0)
+        freezers->get_engine(0).set_magnitude_snapshot(&magnitude_snapshot);
+    for (int channel = 0; channel < num_channels; channel++)
+        freezers->get_engine(channel).set_freeze_bank(freeze_bank.get(), channel);
+    
+    requested_window_type = get_window_type(*window_type_parameter);
+    freezers->for_each_engine([this] (JVFreezer &freezer)
+    {
+        freezer.set_window_type(requested_window_type);
+    });
+    
+    // the output is n_fft (n_fft / 2 in low latency) samples behind the input
+    latency_samples = freezers->get_latency_samples();
+    tail_samples = freezers->get_tail_samples();
+    setLatencySamples (latency_samples);
 }
 
 void SpectralFreezeAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    rt_guard::print_violations();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -116,12 +189,9 @@ bool SpectralFreezeAudioProcessor::isBusesLayoutSupported (const BusesLayout& la
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Every channel gets its own freezer, up to max_channels.
+    int num_channels = layouts.getMainOutputChannelSet().size();
+    if (num_channels < 1 || num_channels > max_channels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -137,33 +207,103 @@ bool SpectralFreezeAudioProcessor::isBusesLayoutSupported (const BusesLayout& la
 
 void SpectralFreezeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    RT_GUARD_SCOPE("SpectralFreeze::processBlock");
+    
     int num_samples = buffer.getNumSamples();
-    int num_channels = buffer.getNumChannels();
+    int num_channels = (freezers == nullptr) ? 0 : juce::jmin (getTotalNumInputChannels(), getTotalNumOutputChannels(), max_channels);
+    
+    // clear outputs without a matching input
+    for (int channel = num_channels; channel < buffer.getNumChannels(); channel++)
+    {
+        buffer.clear(channel, 0, num_samples);
+    }
+    
+    if (freezers == nullptr)
+        return;
     
     bool current_freeze_toggle = !(*freeze_toggle_parameter < 0.5f);
     
     if (current_freeze_toggle != previous_freeze_toggle)
     {
-        freezer.set_is_freeze_active(current_freeze_toggle);
+        freezers->for_each_engine([current_freeze_toggle] (JVFreezer &freezer)
+        {
+            freezer.set_is_freeze_active(current_freeze_toggle);
+        });
         previous_freeze_toggle = current_freeze_toggle;
     }
     
-    // process
-    juce::AudioBuffer<float> output (1, num_samples);
-    auto r = buffer.getReadPointer(0);
-    auto w = output.getWritePointer(0);
-    for (int n = 0; n < num_samples; n++)
+    // a new fft size or latency mode is built in the background and crossfaded in
+    int n_fft = get_n_fft(*fft_size_parameter);
+    bool low_latency = !(*low_latency_parameter < 0.5f);
+    if (n_fft != requested_n_fft || low_latency != requested_low_latency)
     {
-        freezer.push(r[n]);
-        w[n] = freezer.read_sum();
-        freezer.advance();
+        freezers->request_geometry(n_fft, n_fft/4, n_fft, low_latency);
+        requested_n_fft = n_fft;
+        requested_low_latency = low_latency;
     }
     
-    // copy output
-    for (int channel = 0; channel < num_channels; channel++)
+    // every engine already holds every window type's tables
+    plan_cache::WindowType window_type = get_window_type(*window_type_parameter);
+    if (window_type != requested_window_type)
+    {
+        freezers->for_each_engine([window_type] (JVFreezer &freezer)
+        {
+            freezer.set_window_type(window_type);
+        });
+        requested_window_type = window_type;
+    }
+    
+    // capture and recall only index the preallocated bank; capture from
+    // the engines being heard
+    bool current_capture_toggle = !(*capture_toggle_parameter < 0.5f);
+    if (current_capture_toggle != previous_capture_toggle)
     {
-        buffer.copyFrom(channel, 0, output, 0, 0, num_samples);
+        int slot = juce::jlimit (0, num_bank_slots - 1, juce::roundToInt (*bank_slot_parameter));
+        for (int channel = 0; channel < freeze_bank->get_num_channels(); channel++)
+            freezers->get_engine(channel).capture_to_bank(slot);
+        previous_capture_toggle = current_capture_toggle;
     }
+    
+    int morph_from = get_bank_slot(*morph_from_parameter);
+    int morph_to = get_bank_slot(*morph_to_parameter);
+    float morph = *morph_parameter;
+    freezers->for_each_engine([morph_from, morph_to, morph] (JVFreezer &freezer)
+    {
+        freezer.set_bank_morph(morph_from, morph_to, morph);
+    });
+    
+    // process in place
+    freezers->process(buffer.getArrayOfReadPointers(), buffer.getArrayOfWritePointers(), num_channels, num_samples);
+    
+    // changes once a new fft size has been crossfaded in
+    latency_samples.store(freezers->get_latency_samples());
+    tail_samples.store(freezers->get_tail_samples());
+}
+
+void SpectralFreezeAudioProcessor::timerCallback()
+{
+    // report a latency the audio thread has switched to
+    int latency = latency_samples.load();
+    if (latency != getLatencySamples())
+        setLatencySamples (latency);
+}
+
+int SpectralFreezeAudioProcessor::get_n_fft(float fft_size_index)
+{
+    // choices 256, 512, ..., 4096
+    return 256 << juce::jlimit (0, 4, juce::roundToInt (fft_size_index));
+}
+
+plan_cache::WindowType SpectralFreezeAudioProcessor::get_window_type(float window_type_index)
+{
+    // choices in plan_cache::WindowType order
+    return static_cast<plan_cache::WindowType>(juce::jlimit (0, plan_cache::num_analysis_types - 1, juce::roundToInt (window_type_index)));
+}
+
+int SpectralFreezeAudioProcessor::get_bank_slot(float slot_index)
+{
+    // choices "Live" (or "Off"), "1", ..., "8"
+    return juce::jlimit (0, num_bank_slots, juce::roundToInt (slot_index)) - 1;
 }
 
 //==============================================================================
@@ -191,9 +331,9 @@ void SpectralFreezeAudioProcessor::setStateInformation (const void* data, int si
     // whose contents will have been created by the getStateInformation() call.
 }
 
-boost::numeric::ublas::vector<float> SpectralFreezeAudioProcessor::get_magnitude()
+SpectrumSnapshot& SpectralFreezeAudioProcessor::get_magnitude_snapshot()
 {
-    return freezer.get_magnitude();
+    return magnitude_snapshot;
 }
 
 //==============================================================================
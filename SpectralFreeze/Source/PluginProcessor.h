@@ -8,16 +8,24 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <boost/numeric/ublas/vector.hpp>
 
 #include <JuceHeader.h>
 
+#include "FreezeBank/FreezeBank.h"
+#include "GeometrySwitcher/GeometrySwitcher.h"
 #include "JVFreezer/JVFreezer.h"
+#include "RealtimeGuard/RealtimeGuard.h"
+#include "SpectrumSnapshot/SpectrumSnapshot.h"
 
 //==============================================================================
 /**
 */
-class SpectralFreezeAudioProcessor  : public juce::AudioProcessor
+class SpectralFreezeAudioProcessor  : public juce::AudioProcessor,
+                                      private juce::Timer
 {
 public:
     //==============================================================================
@@ -57,7 +65,8 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    boost::numeric::ublas::vector<float> get_magnitude();
+    /* magnitudes of the first channel, published once per hop */
+    SpectrumSnapshot& get_magnitude_snapshot();
 private:
     //==============================================================================
     juce::AudioProcessorValueTreeState parameters;
@@ -65,7 +74,52 @@ private:
     bool previous_freeze_toggle {true};
     std::atomic<float*> freeze_toggle_parameter;
     
-    JVFreezer freezer;
+    /* outlives the freezers, which publish into it */
+    static constexpr int max_snapshot_bins {4097};
+    SpectrumSnapshot magnitude_snapshot {max_snapshot_bins};
+    
+    /* fft size, frame_size n_fft and hop_size n_fft / 4 */
+    std::atomic<float*> fft_size_parameter;
+    int requested_n_fft {1024};
+    
+    /* asymmetric windows, latency n_fft / 2 instead of n_fft, for live use */
+    std::atomic<float*> low_latency_parameter;
+    bool requested_low_latency {false};
+    static int get_n_fft(float fft_size_index);
+    
+    /* analysis window, switched on the running engines */
+    std::atomic<float*> window_type_parameter;
+    plan_cache::WindowType requested_window_type {plan_cache::WindowType::hann};
+    static plan_cache::WindowType get_window_type(float window_type_index);
+    
+    /* captured freezes: each change of the capture toggle stores the
+       freeze in bankSlot; while frozen, morphFrom is played, morphing per
+       bin toward morphTo. Created in prepareToPlay, kept while the channel
+       count stays, and outlives the freezers, which index into it. */
+    static constexpr int num_bank_slots {8};
+    static constexpr int max_bank_bins {4096/2 + 1};     // the largest fft size's
+    std::unique_ptr<FreezeBank> freeze_bank;
+    bool previous_capture_toggle {false};
+    std::atomic<float*> bank_slot_parameter;
+    std::atomic<float*> capture_toggle_parameter;
+    std::atomic<float*> morph_from_parameter;
+    std::atomic<float*> morph_to_parameter;
+    std::atomic<float*> morph_parameter;
+    /* choices "Live" / "Off", "1", ...: -1 for the first */
+    static int get_bank_slot(float slot_index);
+    
+    /* one engine per channel, created in prepareToPlay and rebuilt in the
+       background when the fft size changes */
+    static constexpr int max_channels {8};
+    std::unique_ptr<GeometrySwitcher<JVFreezer> > freezers;
+    
+    /* latency and tail of the freezers being heard, in samples. The audio
+       thread stores them after every block; setLatencySamples notifies the
+       host, so it's called from timerCallback on the message thread. */
+    std::atomic<int> latency_samples {0};
+    std::atomic<int> tail_samples {0};
+    static constexpr int latency_poll_hz {10};
+    void timerCallback() override;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectralFreezeAudioProcessor)
 };
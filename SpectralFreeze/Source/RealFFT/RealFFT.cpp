@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    RealFFT.cpp
+    Created: 17 Oct 2026 4:24:12am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "RealFFT.h"
+
+RealFFT::RealFFT(int n_fft)
+{
+    if (n_fft % 2 != 0)
+        throw std::length_error("n_fft must be even");
+    
+    this->n_fft     = n_fft;
+    this->num_bins  = n_fft/2 + 1;
+    
+    forward_plan    = plan_cache::get_fft_plan(n_fft/2, false);
+    inverse_plan    = plan_cache::get_fft_plan(n_fft/2, true);
+    split_twiddles  = plan_cache::get_split_twiddles(n_fft);
+    half_spectrum   = aligned_vector<kiss_fft_cpx> (n_fft/2);
+    
+    pair_forward_plan = plan_cache::get_fft_plan(n_fft, false);
+    pair_inverse_plan = plan_cache::get_fft_plan(n_fft, true);
+    pair_time       = aligned_vector<kiss_fft_cpx> (n_fft);
+    pair_spectrum   = aligned_vector<kiss_fft_cpx> (n_fft);
+}
+
+void RealFFT::forward(const float *time_in, std::complex<float> *spectrum_out)
+{
+    int m = n_fft/2;
+    
+    // z[n] = x[2n] + i x[2n+1]: the real samples read as m complex points
+    kiss_fft(forward_plan.get(), reinterpret_cast<const kiss_fft_cpx*>(time_in), &half_spectrum(0));
+    
+    /* separate: X[k] = E[k] + exp(-2 pi i k / n_fft) O[k], where
+       E[k] = (Z[k] + conj(Z[m-k])) / 2 and O[k] = (Z[k] - conj(Z[m-k])) / 2i */
+    const kiss_fft_cpx *Z = &half_spectrum(0);
+    const std::complex<float> *t = &(*split_twiddles)[0];
+    
+    spectrum_out[0] = std::complex<float> (Z[0].r + Z[0].i, 0.0f);
+    spectrum_out[m] = std::complex<float> (Z[0].r - Z[0].i, 0.0f);
+    for (int k = 1; k < m; k++)
+    {
+        const kiss_fft_cpx &zk = Z[k];
+        const kiss_fft_cpx &zmk = Z[m - k];
+        float even_re = 0.5f * (zk.r + zmk.r);
+        float even_im = 0.5f * (zk.i - zmk.i);
+        float odd_re  = 0.5f * (zk.i + zmk.i);
+        float odd_im  = 0.5f * (zmk.r - zk.r);
+        spectrum_out[k] = std::complex<float> (even_re + t[k].real() * odd_re - t[k].imag() * odd_im,
+                                               even_im + t[k].real() * odd_im + t[k].imag() * odd_re);
+    }
+}
+
+void RealFFT::inverse(const std::complex<float> *spectrum_in, float *time_out, float gain, const float *window)
+{
+    int m = n_fft/2;
+    
+    /* combine: Z[k] = E[k] + i O[k], where E[k] = X[k] + conj(X[m-k]) and
+       O[k] = (X[k] - conj(X[m-k])) exp(2 pi i k / n_fft). DC and Nyquist
+       are taken as real, as kiss_fftri does. */
+    kiss_fft_cpx *Z = &half_spectrum(0);
+    const std::complex<float> *t = &(*split_twiddles)[0];
+    
+    Z[0].r = spectrum_in[0].real() + spectrum_in[m].real();
+    Z[0].i = spectrum_in[0].real() - spectrum_in[m].real();
+    for (int k = 1; k < m; k++)
+    {
+        const std::complex<float> &xk = spectrum_in[k];
+        const std::complex<float> &xmk = spectrum_in[m - k];
+        float even_re = xk.real() + xmk.real();
+        float even_im = xk.imag() - xmk.imag();
+        float diff_re = xk.real() - xmk.real();
+        float diff_im = xk.imag() + xmk.imag();
+        float odd_re  = diff_re * t[k].real() + diff_im * t[k].imag();
+        float odd_im  = diff_im * t[k].real() - diff_re * t[k].imag();
+        Z[k].r = even_re - odd_im;
+        Z[k].i = even_im + odd_re;
+    }
+    
+    // x[2n] = Re z[n], x[2n+1] = Im z[n]
+    kiss_fft(inverse_plan.get(), Z, reinterpret_cast<kiss_fft_cpx*>(time_out));
+    
+    // the inverse is unscaled: fold 1/n_fft, gain and window into one pass
+    scale_out(time_out, gain / static_cast<float>(n_fft), window, n_fft);
+}
+
+void RealFFT::forward_pair(const float *time_in_a, const float *time_in_b,
+                           std::complex<float> *spectrum_out_a, std::complex<float> *spectrum_out_b)
+{
+    /* pack: z = a + i b */
+    kiss_fft_cpx *z = &pair_time(0);
+    for (int n = 0; n < n_fft; n++)
+    {
+        z[n].r = time_in_a[n];
+        z[n].i = time_in_b[n];
+    }
+    
+    kiss_fft(pair_forward_plan.get(), z, &pair_spectrum(0));
+    
+    /* separate: A[k] = (Z[k] + conj(Z[N-k])) / 2,  B[k] = (Z[k] - conj(Z[N-k])) / 2i */
+    const kiss_fft_cpx *Z = &pair_spectrum(0);
+    for (int k = 0; k < num_bins; k++)
+    {
+        const kiss_fft_cpx &zk = Z[k];
+        const kiss_fft_cpx &znk = Z[(n_fft - k) % n_fft];
+        spectrum_out_a[k] = std::complex<float>(0.5f * (zk.r + znk.r), 0.5f * (zk.i - znk.i));
+        spectrum_out_b[k] = std::complex<float>(0.5f * (zk.i + znk.i), 0.5f * (znk.r - zk.r));
+    }
+}
+
+void RealFFT::inverse_pair(const std::complex<float> *spectrum_in_a, const std::complex<float> *spectrum_in_b,
+                           float *time_out_a, float *time_out_b,
+                           const float *window_a, const float *window_b)
+{
+    /* pack: Z = A + i B over the whole circle, using Hermitian symmetry of
+       A and B. DC and Nyquist are taken as real, as kiss_fftri does. */
+    kiss_fft_cpx *Z = &pair_spectrum(0);
+    int nyquist = num_bins - 1;
+    
+    Z[0].r = spectrum_in_a[0].real();
+    Z[0].i = spectrum_in_b[0].real();
+    Z[nyquist].r = spectrum_in_a[nyquist].real();
+    Z[nyquist].i = spectrum_in_b[nyquist].real();
+    for (int k = 1; k < nyquist; k++)
+    {
+        const std::complex<float> &a = spectrum_in_a[k];
+        const std::complex<float> &b = spectrum_in_b[k];
+        // Z[k] = A[k] + i B[k]
+        Z[k].r = a.real() - b.imag();
+        Z[k].i = a.imag() + b.real();
+        // Z[N-k] = conj(A[k]) + i conj(B[k])
+        Z[n_fft - k].r = a.real() + b.imag();
+        Z[n_fft - k].i = b.real() - a.imag();
+    }
+    
+    kiss_fft(pair_inverse_plan.get(), Z, &pair_time(0));
+    
+    /* unpack: a = Re z, b = Im z */
+    const kiss_fft_cpx *z = &pair_time(0);
+    for (int n = 0; n < n_fft; n++)
+    {
+        time_out_a[n] = z[n].r;
+        time_out_b[n] = z[n].i;
+    }
+    
+    float scale = 1.0f / static_cast<float>(n_fft);
+    scale_out(time_out_a, scale, window_a, n_fft);
+    scale_out(time_out_b, scale, window_b, n_fft);
+}
+
+void RealFFT::scale_out(float *time_out, float scale, const float *window, int len)
+{
+    if (window == nullptr)
+    {
+        for (int n = 0; n < len; n++)
+        {
+            time_out[n] *= scale;
+        }
+    }
+    else
+    {
+        for (int n = 0; n < len; n++)
+        {
+            time_out[n] *= scale * window[n];
+        }
+    }
+}
+
+int RealFFT::get_n_fft()
+{
+    return n_fft;
+}
+int RealFFT::get_num_bins()
+{
+    return num_bins;
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    RealFFT.h
+    Created: 17 Oct 2026 4:24:12am
+    Author:  agent
+
+        Out-of-place real FFT for the audio thread.
+ 
+    Transforms between caller-supplied buffers:
+ 
+        forward:    n_fft real samples  ->  num_bins = n_fft/2 + 1 bins
+        inverse:    num_bins bins       ->  n_fft real samples, * gain / n_fft
+                                            (and * window, if given)
+ 
+    Two real frames (e.g. a stereo pair) can share one complex kiss_fft of
+    length n_fft: one frame goes in the real part, the other in the
+    imaginary part, and the two half-spectra are separated by symmetry.
+ 
+        forward_pair:   2 x n_fft real    ->  2 x num_bins bins
+        inverse_pair:   2 x num_bins bins ->  2 x n_fft real, / n_fft
+ 
+    The real transforms pack n_fft samples into n_fft/2 complex points and
+    separate the bins by symmetry, as kiss_fftr does, but on complex plans
+    from plan_cache: every RealFFT of the same length shares its plans and
+    split twiddles and only owns its scratch buffers. Shared plans are only
+    ever used out of place.
+ 
+    Nothing is allocated after construction, and because every transform
+    is out of place kiss_fft never allocates its temporary buffer either.
+    Use aligned_vector for buffers that are handed to it.
+ 
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <kiss_fft/kiss_fft.h>
+#include <kiss_fft/_kiss_fft_guts.h>
+
+#include "../PlanCache/PlanCache.h"
+
+namespace bst = boost::numeric::ublas;
+
+class RealFFT
+{
+    
+public:
+    RealFFT(int n_fft);
+    
+    /* n_fft real samples -> num_bins complex bins */
+    void forward(const float *time_in, std::complex<float> *spectrum_out);
+    /* num_bins complex bins -> n_fft real samples, scaled by gain / n_fft
+       and optionally by a synthesis window in the same pass */
+    void inverse(const std::complex<float> *spectrum_in, float *time_out, float gain = 1.0f, const float *window = nullptr);
+    
+    /* two real frames through one complex fft */
+    void forward_pair(const float *time_in_a, const float *time_in_b,
+                      std::complex<float> *spectrum_out_a, std::complex<float> *spectrum_out_b);
+    /* two half-spectra through one complex inverse fft, each output scaled by
+       1 / n_fft and optionally by its own synthesis window */
+    void inverse_pair(const std::complex<float> *spectrum_in_a, const std::complex<float> *spectrum_in_b,
+                      float *time_out_a, float *time_out_b,
+                      const float *window_a = nullptr, const float *window_b = nullptr);
+    
+    int get_n_fft();
+    int get_num_bins();
+    
+private:
+    int n_fft;
+    int num_bins;
+    
+    /* shared: complex plans of length n_fft/2 and the split factors for
+       the real transforms */
+    std::shared_ptr<kiss_fft_state> forward_plan;
+    std::shared_ptr<kiss_fft_state> inverse_plan;
+    std::shared_ptr<const std::vector<std::complex<float> > > split_twiddles;
+    aligned_vector<kiss_fft_cpx> half_spectrum;
+    
+    /* shared complex plans of length n_fft and buffers for the packed pair
+       transforms */
+    std::shared_ptr<kiss_fft_state> pair_forward_plan;
+    std::shared_ptr<kiss_fft_state> pair_inverse_plan;
+    aligned_vector<kiss_fft_cpx> pair_time;
+    aligned_vector<kiss_fft_cpx> pair_spectrum;
+    
+    static void scale_out(float *time_out, float scale, const float *window, int len);
+    
+    RealFFT(const RealFFT&) = delete;
+    RealFFT& operator=(const RealFFT&) = delete;
+};
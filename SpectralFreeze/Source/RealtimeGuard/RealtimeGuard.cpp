@@ -0,0 +1,504 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 17 Oct 2026 4:44:44am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+
+#if RT_GUARD
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <dlfcn.h>
+#include <pthread.h>
+
+#include <JuceHeader.h>
+
+#if defined(__APPLE__) && defined(__LP64__)
+ #define RT_GUARD_MACH_O 1
+ #include <malloc/malloc.h>
+ #include <mach/mach.h>
+ #include <mach-o/dyld.h>
+ #include <mach-o/loader.h>
+ #include <mach-o/nlist.h>
+#elif defined(__GLIBC__)
+ #define RT_GUARD_GLIBC 1
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void *p, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *p);
+}
+#endif
+
+namespace rt_guard
+{
+    //============ Thread state ===================================================
+    
+    /* innermost ScopedRealtime of each thread, nullptr outside any scope */
+    static pthread_key_t scope_key;
+    static pthread_once_t scope_key_once = PTHREAD_ONCE_INIT;
+    /* threads inside a scope: cheap early out for every other thread */
+    static std::atomic<int> active_scopes {0};
+    
+    static void create_scope_key()
+    {
+        pthread_key_create(&scope_key, nullptr);
+    }
+    
+    ScopedRealtime::ScopedRealtime(const char *tag)
+    {
+        pthread_once(&scope_key_once, create_scope_key);
+        this->tag = tag;
+        parent = static_cast<ScopedRealtime*>(pthread_getspecific(scope_key));
+        pthread_setspecific(scope_key, this);
+        active_scopes++;
+    }
+    
+    ScopedRealtime::~ScopedRealtime()
+    {
+        active_scopes--;
+        pthread_setspecific(scope_key, parent);
+    }
+    
+    static inline void check(const char *kind)
+    {
+        if (active_scopes.load(std::memory_order_relaxed) > 0)
+            report(kind);
+    }
+    
+    //============ Records ========================================================
+    
+    /* fixed storage, so recording from inside malloc cannot allocate */
+    static constexpr int max_records    {64};
+    static constexpr int max_text       {192};
+    static constexpr int max_depth      {8};
+    
+    struct Record
+    {
+        char text[max_text];
+        std::atomic<bool> is_ready {false};
+    };
+    static Record records[max_records];
+    static std::atomic<long> violation_count {0};
+    
+    static int append(char *text, int pos, const char *s)
+    {
+        while (*s != '\0' && pos < max_text - 1)
+            text[pos++] = *s++;
+        text[pos] = '\0';
+        return pos;
+    }
+    
+    void report(const char *kind)
+    {
+        if (active_scopes.load(std::memory_order_relaxed) == 0)
+            return;
+        auto *scope = static_cast<ScopedRealtime*>(pthread_getspecific(scope_key));
+        if (scope == nullptr || scope->is_reporting)
+            return;
+        scope->is_reporting = true;
+        
+        long i = violation_count.fetch_add(1);
+        if (i < max_records)
+        {
+            // kind @ outermost > ... > innermost
+            const char *tags[max_depth];
+            int depth = 0;
+            for (auto *s = scope; s != nullptr && depth < max_depth; s = s->parent)
+                tags[depth++] = s->tag;
+            
+            char *text = records[i].text;
+            int pos = append(text, 0, kind);
+            pos = append(text, pos, " @ ");
+            for (int d = depth - 1; d >= 0; d--)
+            {
+                pos = append(text, pos, tags[d]);
+                if (d > 0)
+                    pos = append(text, pos, " > ");
+            }
+            records[i].is_ready.store(true, std::memory_order_release);
+        }
+        
+        scope->is_reporting = false;
+        
+       #if RT_GUARD_TRAP
+        jassertfalse;
+       #endif
+    }
+    
+    long get_violation_count()
+    {
+        return violation_count.load();
+    }
+    
+    void print_violations()
+    {
+        long count = violation_count.exchange(0);
+        if (count == 0)
+            return;
+        
+        std::fprintf(stderr, "rt_guard: %ld realtime violation(s)\n", count);
+        for (long i = 0; i < count && i < max_records; i++)
+        {
+            if (records[i].is_ready.exchange(false, std::memory_order_acquire))
+                std::fprintf(stderr, "  %s\n", records[i].text);
+        }
+        if (count > max_records)
+            std::fprintf(stderr, "  (%ld more not recorded)\n", count - max_records);
+    }
+    
+    //============ Interception ===================================================
+    
+   #if RT_GUARD_MACH_O
+    /* default malloc zone, patched in place */
+    static void* (*zone_malloc)(malloc_zone_t*, size_t) {nullptr};
+    static void* (*zone_calloc)(malloc_zone_t*, size_t, size_t) {nullptr};
+    static void* (*zone_realloc)(malloc_zone_t*, void*, size_t) {nullptr};
+    static void* (*zone_memalign)(malloc_zone_t*, size_t, size_t) {nullptr};
+    
+    static void* guarded_zone_malloc(malloc_zone_t *zone, size_t size)
+    {
+        check("malloc");
+        return zone_malloc(zone, size);
+    }
+    static void* guarded_zone_calloc(malloc_zone_t *zone, size_t count, size_t size)
+    {
+        check("calloc");
+        return zone_calloc(zone, count, size);
+    }
+    static void* guarded_zone_realloc(malloc_zone_t *zone, void *p, size_t size)
+    {
+        check("realloc");
+        return zone_realloc(zone, p, size);
+    }
+    static void* guarded_zone_memalign(malloc_zone_t *zone, size_t alignment, size_t size)
+    {
+        check("memalign");
+        return zone_memalign(zone, alignment, size);
+    }
+    
+    static void install_zone_hooks()
+    {
+        malloc_zone_t *zone = malloc_default_zone();
+        vm_protect(mach_task_self(), reinterpret_cast<vm_address_t>(zone), sizeof(malloc_zone_t), 0,
+                   VM_PROT_READ | VM_PROT_WRITE);
+        zone_malloc     = zone->malloc;
+        zone_calloc     = zone->calloc;
+        zone_realloc    = zone->realloc;
+        zone->malloc    = guarded_zone_malloc;
+        zone->calloc    = guarded_zone_calloc;
+        zone->realloc   = guarded_zone_realloc;
+        // posix_memalign and aligned_alloc (zone version 5 on)
+        if (zone->version >= 5 && zone->memalign != nullptr)
+        {
+            zone_memalign   = zone->memalign;
+            zone->memalign  = guarded_zone_memalign;
+        }
+        vm_protect(mach_task_self(), reinterpret_cast<vm_address_t>(zone), sizeof(malloc_zone_t), 0,
+                   VM_PROT_READ);
+    }
+    
+    /* pthread_mutex_lock: rebind the symbol pointers of every loaded image */
+    static int (*real_mutex_lock)(pthread_mutex_t*) {nullptr};
+    
+    static int guarded_mutex_lock(pthread_mutex_t *mutex)
+    {
+        check("pthread_mutex_lock");
+        return real_mutex_lock(mutex);
+    }
+    
+    static void rebind_section(const section_64 *section, intptr_t slide, const nlist_64 *symtab,
+                               const char *strtab, const uint32_t *indirect_symtab)
+    {
+        const uint32_t *indices = indirect_symtab + section->reserved1;
+        void **bindings = reinterpret_cast<void**>(slide + section->addr);
+        
+        for (uint64_t i = 0; i < section->size / sizeof(void*); i++)
+        {
+            uint32_t index = indices[i];
+            if (index & (INDIRECT_SYMBOL_ABS | INDIRECT_SYMBOL_LOCAL))
+                continue;
+            if (std::strcmp(strtab + symtab[index].n_un.n_strx, "_pthread_mutex_lock") != 0)
+                continue;
+            
+            vm_protect(mach_task_self(), reinterpret_cast<vm_address_t>(bindings + i), sizeof(void*), 0,
+                       VM_PROT_READ | VM_PROT_WRITE | VM_PROT_COPY);
+            bindings[i] = reinterpret_cast<void*>(guarded_mutex_lock);
+        }
+    }
+    
+    static void rebind_image(const struct mach_header *mh, intptr_t slide)
+    {
+        auto *header = reinterpret_cast<const mach_header_64*>(mh);
+        const segment_command_64 *linkedit = nullptr;
+        const symtab_command *symtab_cmd = nullptr;
+        const dysymtab_command *dysymtab_cmd = nullptr;
+        
+        // find the tables
+        auto cmd = reinterpret_cast<uintptr_t>(header + 1);
+        for (uint32_t i = 0; i < header->ncmds; i++)
+        {
+            auto *lc = reinterpret_cast<const load_command*>(cmd);
+            if (lc->cmd == LC_SEGMENT_64
+                && std::strcmp(reinterpret_cast<const segment_command_64*>(lc)->segname, SEG_LINKEDIT) == 0)
+                linkedit = reinterpret_cast<const segment_command_64*>(lc);
+            else if (lc->cmd == LC_SYMTAB)
+                symtab_cmd = reinterpret_cast<const symtab_command*>(lc);
+            else if (lc->cmd == LC_DYSYMTAB)
+                dysymtab_cmd = reinterpret_cast<const dysymtab_command*>(lc);
+            cmd += lc->cmdsize;
+        }
+        if (linkedit == nullptr || symtab_cmd == nullptr || dysymtab_cmd == nullptr
+            || dysymtab_cmd->nindirectsyms == 0)
+            return;
+        
+        uintptr_t linkedit_base = slide + linkedit->vmaddr - linkedit->fileoff;
+        auto *symtab = reinterpret_cast<const nlist_64*>(linkedit_base + symtab_cmd->symoff);
+        auto *strtab = reinterpret_cast<const char*>(linkedit_base + symtab_cmd->stroff);
+        auto *indirect_symtab = reinterpret_cast<const uint32_t*>(linkedit_base + dysymtab_cmd->indirectsymoff);
+        
+        // rebind in the symbol pointer sections of __DATA and __DATA_CONST
+        cmd = reinterpret_cast<uintptr_t>(header + 1);
+        for (uint32_t i = 0; i < header->ncmds; i++)
+        {
+            auto *lc = reinterpret_cast<const load_command*>(cmd);
+            cmd += lc->cmdsize;
+            if (lc->cmd != LC_SEGMENT_64)
+                continue;
+            
+            auto *segment = reinterpret_cast<const segment_command_64*>(lc);
+            if (std::strcmp(segment->segname, SEG_DATA) != 0 && std::strcmp(segment->segname, "__DATA_CONST") != 0)
+                continue;
+            
+            auto *sections = reinterpret_cast<const section_64*>(segment + 1);
+            for (uint32_t s = 0; s < segment->nsects; s++)
+            {
+                uint32_t type = sections[s].flags & SECTION_TYPE;
+                if (type == S_LAZY_SYMBOL_POINTERS || type == S_NON_LAZY_SYMBOL_POINTERS)
+                    rebind_section(&sections[s], slide, symtab, strtab, indirect_symtab);
+            }
+        }
+    }
+    
+    static void* raw_malloc(size_t size)
+    {
+        return zone_malloc != nullptr ? zone_malloc(malloc_default_zone(), size) : std::malloc(size);
+    }
+    static void* raw_aligned_malloc(size_t alignment, size_t size)
+    {
+        return zone_memalign != nullptr ? zone_memalign(malloc_default_zone(), alignment, size)
+                                        : malloc_zone_memalign(malloc_default_zone(), alignment, size);
+    }
+    static void raw_free(void *p)
+    {
+        std::free(p);
+    }
+    
+    static bool install()
+    {
+        real_mutex_lock = reinterpret_cast<int(*)(pthread_mutex_t*)>(dlsym(RTLD_DEFAULT, "pthread_mutex_lock"));
+        install_zone_hooks();
+        // called now for every loaded image, and later for each new one
+        _dyld_register_func_for_add_image(rebind_image);
+        return true;
+    }
+   #elif RT_GUARD_GLIBC
+    static int (*real_mutex_lock)(pthread_mutex_t*) {nullptr};
+    
+    static int (*get_real_mutex_lock())(pthread_mutex_t*)
+    {
+        // may be needed before install() has run
+        if (real_mutex_lock == nullptr)
+            real_mutex_lock = reinterpret_cast<int(*)(pthread_mutex_t*)>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        return real_mutex_lock;
+    }
+    
+    static void* raw_malloc(size_t size)
+    {
+        return __libc_malloc(size);
+    }
+    static void* raw_aligned_malloc(size_t alignment, size_t size)
+    {
+        return __libc_memalign(alignment, size);
+    }
+    static void raw_free(void *p)
+    {
+        __libc_free(p);
+    }
+    
+    static bool install()
+    {
+        get_real_mutex_lock();
+        return true;
+    }
+   #else
+    /* no malloc or mutex interception on this platform, operator new only */
+    static void* raw_malloc(size_t size)
+    {
+        return std::malloc(size);
+    }
+    static void raw_free(void *p)
+    {
+        std::free(p);
+    }
+   #if defined(_WIN32)
+    static void* raw_aligned_malloc(size_t alignment, size_t size)
+    {
+        return _aligned_malloc(size, alignment);
+    }
+    static void raw_aligned_free(void *p)
+    {
+        _aligned_free(p);
+    }
+   #else
+    static void* raw_aligned_malloc(size_t alignment, size_t size)
+    {
+        void *p = nullptr;
+        return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+    }
+    static void raw_aligned_free(void *p)
+    {
+        std::free(p);
+    }
+   #endif
+    
+    static bool install()
+    {
+        return true;
+    }
+   #endif
+    
+   #if RT_GUARD_MACH_O || RT_GUARD_GLIBC
+    /* memalign'd blocks go back through free */
+    static void raw_aligned_free(void *p)
+    {
+        raw_free(p);
+    }
+   #endif
+    
+    static const bool is_installed = install();
+}
+
+//============ Replacements ======================================================
+
+#if RT_GUARD_GLIBC
+extern "C"
+{
+    void* malloc(size_t size)
+    {
+        rt_guard::check("malloc");
+        return __libc_malloc(size);
+    }
+    void* calloc(size_t count, size_t size)
+    {
+        rt_guard::check("calloc");
+        return __libc_calloc(count, size);
+    }
+    void* realloc(void *p, size_t size)
+    {
+        rt_guard::check("realloc");
+        return __libc_realloc(p, size);
+    }
+    /* aligned: boost::alignment::aligned_alloc (aligned_vector,
+       FixedVocodeur) comes through posix_memalign */
+    int posix_memalign(void **p, size_t alignment, size_t size)
+    {
+        rt_guard::check("posix_memalign");
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+        *p = __libc_memalign(alignment, size);
+        return *p != nullptr ? 0 : ENOMEM;
+    }
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        rt_guard::check("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+    void* memalign(size_t alignment, size_t size)
+    {
+        rt_guard::check("memalign");
+        return __libc_memalign(alignment, size);
+    }
+    int pthread_mutex_lock(pthread_mutex_t *mutex)
+    {
+        rt_guard::check("pthread_mutex_lock");
+        return rt_guard::get_real_mutex_lock()(mutex);
+    }
+}
+#endif
+
+void* operator new (std::size_t size)
+{
+    rt_guard::check("operator new");
+    if (void *p = rt_guard::raw_malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void operator delete (void *p) noexcept
+{
+    rt_guard::raw_free(p);
+}
+
+void operator delete[] (void *p) noexcept               { operator delete (p); }
+void operator delete (void *p, std::size_t) noexcept    { operator delete (p); }
+void operator delete[] (void *p, std::size_t) noexcept  { operator delete (p); }
+
+#if __cpp_aligned_new
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    rt_guard::check("operator new");
+    // memalign wants at least pointer alignment
+    std::size_t a = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    if (void *p = rt_guard::raw_aligned_malloc(a, size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return operator new (size, alignment);
+}
+
+void operator delete (void *p, std::align_val_t) noexcept
+{
+    rt_guard::raw_aligned_free(p);
+}
+
+void operator delete[] (void *p, std::align_val_t alignment) noexcept               { operator delete (p, alignment); }
+void operator delete (void *p, std::size_t, std::align_val_t alignment) noexcept    { operator delete (p, alignment); }
+void operator delete[] (void *p, std::size_t, std::align_val_t alignment) noexcept  { operator delete (p, alignment); }
+#endif
+
+#else
+
+namespace rt_guard
+{
+    ScopedRealtime::ScopedRealtime(const char *tag) : tag(tag), parent(nullptr) {}
+    ScopedRealtime::~ScopedRealtime() {}
+    
+    void report(const char *) {}
+    long get_violation_count() { return 0; }
+    void print_violations() {}
+}
+
+#endif
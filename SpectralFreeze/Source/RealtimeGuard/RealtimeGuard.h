@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 17 Oct 2026 4:44:44am
+    Author:  agent
+
+        Instrumentation build mode that catches realtime-unsafe calls on the
+        audio thread.
+ 
+    Build with RT_GUARD=1 (Projucer: Preprocessor Definitions). While a
+    RT_GUARD_SCOPE is alive on a thread, these count as violations:
+ 
+        operator new / new[]        (and the aligned forms)
+        malloc, calloc, realloc,    (macOS: default malloc zone,
+        posix_memalign,              glibc: __libc_* wrappers)
+        aligned_alloc, memalign
+        pthread_mutex_lock          (macOS: rebound in loaded images,
+                                     glibc: RTLD_NEXT wrapper)
+ 
+    Each violation is recorded with its kind and the stack of scope tags,
+    e.g. "malloc @ SpectralFreeze::processBlock > PhaseVocodeur3::spectral_processing".
+    Recording never allocates; print_violations() prints them later from a
+    non-realtime thread. With RT_GUARD_TRAP=1 a violation also hits
+    jassertfalse, so a debugger stops at the offending call.
+ 
+    With RT_GUARD=0 (default) RT_GUARD_SCOPE expands to nothing and nothing
+    is intercepted.
+ 
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifndef RT_GUARD
+ #define RT_GUARD 0
+#endif
+
+#ifndef RT_GUARD_TRAP
+ #define RT_GUARD_TRAP 0
+#endif
+
+namespace rt_guard
+{
+    /* marks the current thread as realtime until destroyed; nests */
+    class ScopedRealtime
+    {
+    public:
+        explicit ScopedRealtime(const char *tag);
+        ~ScopedRealtime();
+        
+        const char *tag;
+        ScopedRealtime *parent;
+        bool is_reporting {false};
+        
+    private:
+        ScopedRealtime(const ScopedRealtime&) = delete;
+        ScopedRealtime& operator=(const ScopedRealtime&) = delete;
+    };
+    
+    /* records a violation for the current thread if it is inside a scope */
+    void report(const char *kind);
+    
+    /* total violations since start (or the last clear) */
+    long get_violation_count();
+    /* prints and clears recorded violations; not realtime safe */
+    void print_violations();
+}
+
+#if RT_GUARD
+ #define RT_GUARD_CONCAT_(a, b) a##b
+ #define RT_GUARD_CONCAT(a, b) RT_GUARD_CONCAT_(a, b)
+ #define RT_GUARD_SCOPE(tag) rt_guard::ScopedRealtime RT_GUARD_CONCAT(rt_guard_scope_, __LINE__) (tag)
+#else
+ #define RT_GUARD_SCOPE(tag)
+#endif
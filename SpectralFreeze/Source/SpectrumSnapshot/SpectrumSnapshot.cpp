@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    SpectrumSnapshot.cpp
+    Created: 17 Oct 2026 4:38:24am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+
+#include "SpectrumSnapshot.h"
+
+SpectrumSnapshot::SpectrumSnapshot(int capacity)
+{
+    this->capacity = capacity;
+    for (auto &b : buffers)
+    {
+        b = bst::zero_vector<float> (capacity);
+    }
+}
+
+//============ Writer =============================================================
+
+float* SpectrumSnapshot::get_write_buffer()
+{
+    return &buffers[back](0);
+}
+
+void SpectrumSnapshot::publish(int size)
+{
+    sizes[back] = std::min(size, capacity);
+    // hand the back buffer over, take the old middle as the next back
+    back = middle.exchange(back | fresh, std::memory_order_acq_rel) & ~fresh;
+}
+
+//============ Reader =============================================================
+
+bool SpectrumSnapshot::update()
+{
+    if ((middle.load(std::memory_order_relaxed) & fresh) == 0)
+        return false;
+    front = middle.exchange(front, std::memory_order_acq_rel) & ~fresh;
+    return true;
+}
+
+const float* SpectrumSnapshot::get_data()
+{
+    return &buffers[front](0);
+}
+
+int SpectrumSnapshot::get_size()
+{
+    return sizes[front];
+}
+
+int SpectrumSnapshot::get_capacity()
+{
+    return capacity;
+}
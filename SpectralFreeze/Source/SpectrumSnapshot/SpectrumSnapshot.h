@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    SpectrumSnapshot.h
+    Created: 17 Oct 2026 4:38:24am
+    Author:  agent
+
+        Lock-free triple buffer of magnitude spectra, from the audio thread
+        to the editor.
+ 
+    One writer (audio thread) and one reader (message thread). The writer
+    fills the back buffer and publishes it once per hop; the reader picks
+    up the latest published buffer whenever it likes. Each side owns one
+    buffer and the third is exchanged through a single atomic index, so
+    neither side waits, tears or allocates.
+ 
+    The capacity (bins per buffer) is fixed at construction, so engines
+    may publish any size up to it without reallocating.
+ 
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+namespace bst = boost::numeric::ublas;
+
+class SpectrumSnapshot
+{
+    
+public:
+    SpectrumSnapshot(int capacity);
+    
+    /* writer: fill get_write_buffer() with up to capacity bins, then publish */
+    float* get_write_buffer();
+    void publish(int size);
+    
+    /* reader: take the latest published buffer, if any since the last
+       update; get_data() / get_size() stay valid until the next update */
+    bool update();
+    const float* get_data();
+    int get_size();
+    
+    int get_capacity();
+    
+private:
+    int capacity;
+    
+    bst::vector<float> buffers[3];
+    int sizes[3]                {0, 0, 0};
+    
+    /* index of the exchanged buffer, | fresh when it is newer than the reader's */
+    static constexpr int fresh  {4};
+    std::atomic<int> middle     {1};
+    int back                    {0};            // owned by the writer
+    int front                   {2};            // owned by the reader
+    
+    SpectrumSnapshot(const SpectrumSnapshot&) = delete;
+    SpectrumSnapshot& operator=(const SpectrumSnapshot&) = delete;
+};
@@ -0,0 +1,815 @@
+/*
+  ==============================================================================
+
+    VectorExpressions.h
+    Created: 17 Oct 2026 5:11:35am
+    Author:  agent
+
+        Lazy element-wise jv_bst operations.
+
+    jv_bst::wrap_to_pi(x), jv_bst::angle(z), ... return expressions instead
+    of vectors, so they nest with each other, with +, -, * and with ublas
+    vectors:
+
+        jv_bst::noalias(dp) = jv_bst::wrap_to_pi(jv_bst::angle(current)
+                                                 - jv_bst::angle(last)
+                                                 - phase_advance);
+
+    is one pass over the bins. jv_bst::noalias evaluates float and
+    complex<float> expressions four bins at a time with the fast_math
+    kernels; assigning with = or bst::noalias works too, one bin at a time.
+    Nodes without a lane version (pow, double vectors, ublas' own x + y
+    between plain vectors, ...) are gathered bin by bin inside the same pass;
+    write jv_bst::add(x, y) to keep such a sum in lanes.
+
+    The output must have the expression's size. It may appear in the
+    expression (e.g. x = wrap_to_pi(x + dx)), since bin k only reads bin k.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/detail/iterator.hpp>
+
+#include "../FastMath/FastMathLanes.h"
+
+namespace jv_bst {
+
+namespace detail {
+
+    namespace ublas = boost::numeric::ublas;
+    namespace lanes_math = fast_math::detail;
+
+#if FAST_MATH_X86
+    using Lanes = lanes_math::Sse2;
+#else
+    using Lanes = lanes_math::Scalar;
+#endif
+
+    //============ Scalar functors ================================================
+    /* ublas functor interface (argument_type, result_type, static apply), so
+       they can sit in vector_unary / vector_binary. The float versions run
+       the same fast_math kernels as the lane path. */
+
+    template <class T> struct abs_functor
+    {
+        typedef T value_type;
+        typedef const T &argument_type;
+        typedef typename ublas::type_traits<T>::real_type result_type;
+        static result_type apply(argument_type t) { return std::abs(t); }
+    };
+    template <> struct abs_functor<std::complex<float> >
+    {
+        typedef std::complex<float> value_type;
+        typedef const value_type &argument_type;
+        typedef float result_type;
+        static result_type apply(argument_type z) { return std::sqrt(z.real() * z.real() + z.imag() * z.imag()); }
+    };
+
+    template <class T> struct angle_functor
+    {
+        typedef T value_type;
+        typedef const T &argument_type;
+        typedef typename ublas::type_traits<T>::real_type result_type;
+        static result_type apply(argument_type z) { return std::arg(z); }
+    };
+    template <> struct angle_functor<std::complex<float> >
+    {
+        typedef std::complex<float> value_type;
+        typedef const value_type &argument_type;
+        typedef float result_type;
+        static result_type apply(argument_type z) { return lanes_math::atan2_kernel<lanes_math::Scalar>(z.imag(), z.real()); }
+    };
+
+    template <class T> struct wrap_to_pi_functor
+    {
+        typedef T value_type;
+        typedef const T &argument_type;
+        typedef T result_type;
+        static result_type apply(argument_type t) { return t - (2.0 * M_PI * std::floor((t + M_PI) / (2.0 * M_PI))); }
+    };
+    template <> struct wrap_to_pi_functor<float>
+    {
+        typedef float value_type;
+        typedef const float &argument_type;
+        typedef float result_type;
+        static result_type apply(argument_type t) { return lanes_math::wrap_kernel<lanes_math::Scalar>(t); }
+    };
+
+    template <class T> struct sin_functor
+    {
+        typedef T value_type;
+        typedef const T &argument_type;
+        typedef T result_type;
+        static result_type apply(argument_type t) { return std::sin(t); }
+    };
+    template <> struct sin_functor<float>
+    {
+        typedef float value_type;
+        typedef const float &argument_type;
+        typedef float result_type;
+        static result_type apply(argument_type t)
+        {
+            float s, c;
+            lanes_math::sincos_kernel<lanes_math::Scalar>(t, s, c);
+            return s;
+        }
+    };
+
+    template <class T> struct cos_functor
+    {
+        typedef T value_type;
+        typedef const T &argument_type;
+        typedef T result_type;
+        static result_type apply(argument_type t) { return std::cos(t); }
+    };
+    template <> struct cos_functor<float>
+    {
+        typedef float value_type;
+        typedef const float &argument_type;
+        typedef float result_type;
+        static result_type apply(argument_type t)
+        {
+            float s, c;
+            lanes_math::sincos_kernel<lanes_math::Scalar>(t, s, c);
+            return c;
+        }
+    };
+
+    template <class T> struct complex_unary_functor
+    {
+        typedef T value_type;
+        typedef const T &argument_type;
+        typedef std::complex<T> result_type;
+        static result_type apply(argument_type r) { return result_type (r); }
+    };
+
+    template <class T1, class T2> struct max_functor : public ublas::scalar_binary_functor<T1, T2>
+    {
+        typedef typename ublas::scalar_binary_functor<T1, T2>::argument1_type argument1_type;
+        typedef typename ublas::scalar_binary_functor<T1, T2>::argument2_type argument2_type;
+        typedef typename ublas::scalar_binary_functor<T1, T2>::result_type result_type;
+        static result_type apply(argument1_type a, argument2_type b) { return a > b ? a : b; }
+    };
+
+    template <class T1, class T2> struct min_functor : public ublas::scalar_binary_functor<T1, T2>
+    {
+        typedef typename ublas::scalar_binary_functor<T1, T2>::argument1_type argument1_type;
+        typedef typename ublas::scalar_binary_functor<T1, T2>::argument2_type argument2_type;
+        typedef typename ublas::scalar_binary_functor<T1, T2>::result_type result_type;
+        static result_type apply(argument1_type a, argument2_type b) { return a < b ? a : b; }
+    };
+
+    template <class T1, class T2> struct pow_functor : public ublas::scalar_binary_functor<T1, T2>
+    {
+        typedef typename ublas::scalar_binary_functor<T1, T2>::argument1_type argument1_type;
+        typedef typename ublas::scalar_binary_functor<T1, T2>::argument2_type argument2_type;
+        typedef typename ublas::scalar_binary_functor<T1, T2>::result_type result_type;
+        static result_type apply(argument1_type a, argument2_type b) { return std::pow(a, b); }
+    };
+
+    template <class T1, class T2> struct complex_functor
+    {
+        typedef const T1 &argument1_type;
+        typedef const T2 &argument2_type;
+        typedef std::complex<typename ublas::promote_traits<T1, T2>::promote_type> result_type;
+        static result_type apply(argument1_type r, argument2_type i) { return result_type (r, i); }
+    };
+
+    template <class T1, class T2> struct pol2cart_functor
+    {
+        typedef const T1 &argument1_type;
+        typedef const T2 &argument2_type;
+        typedef std::complex<typename ublas::promote_traits<T1, T2>::promote_type> result_type;
+        static result_type apply(argument1_type r, argument2_type p) { return std::polar(r, p); }
+    };
+    template <> struct pol2cart_functor<float, float>
+    {
+        typedef const float &argument1_type;
+        typedef const float &argument2_type;
+        typedef std::complex<float> result_type;
+        static result_type apply(argument1_type r, argument2_type p)
+        {
+            float s, c;
+            lanes_math::sincos_kernel<lanes_math::Scalar>(p, s, c);
+            return result_type (r * c, r * s);
+        }
+    };
+
+    //============ Lane versions ==================================================
+    /* lane_op<F> is F on S::width bins at once. Each op loads its operands
+       through their own lanes<> so a whole tree inlines into one loop body. */
+
+    template <class F> struct lane_op { static const bool value = false; };
+
+    template <class Op> struct real_binary_lane_op
+    {
+        static const bool value = true;
+        template <class S, class L1, class L2, class E1, class E2>
+        static typename S::V load(const E1 &e1, const E2 &e2, std::size_t i)
+        {
+            return Op::template apply<S>(L1::load(e1, i), L2::load(e2, i));
+        }
+    };
+
+    template <class Op> struct real_unary_lane_op
+    {
+        static const bool value = true;
+        template <class S, class L, class E>
+        static typename S::V load(const E &e, std::size_t i)
+        {
+            return Op::template apply<S>(L::load(e, i));
+        }
+    };
+
+    template <class Op> struct complex_to_real_lane_op
+    {
+        static const bool value = true;
+        template <class S, class L, class E>
+        static typename S::V load(const E &e, std::size_t i)
+        {
+            typename S::V re, im;
+            L::load(e, i, re, im);
+            return Op::template apply<S>(re, im);
+        }
+    };
+
+    struct plus_op      { template <class S> static typename S::V apply(typename S::V a, typename S::V b) { return S::add(a, b); } };
+    struct minus_op     { template <class S> static typename S::V apply(typename S::V a, typename S::V b) { return S::sub(a, b); } };
+    struct multiply_op  { template <class S> static typename S::V apply(typename S::V a, typename S::V b) { return S::mul(a, b); } };
+    struct divide_op    { template <class S> static typename S::V apply(typename S::V a, typename S::V b) { return S::div(a, b); } };
+    struct max_op       { template <class S> static typename S::V apply(typename S::V a, typename S::V b) { return S::select(S::gt(a, b), a, b); } };
+    struct min_op       { template <class S> static typename S::V apply(typename S::V a, typename S::V b) { return S::select(S::lt(a, b), a, b); } };
+
+    struct negate_op    { template <class S> static typename S::V apply(typename S::V a) { return S::bit_xor(a, lanes_math::sign_mask<S>()); } };
+    struct fabs_op      { template <class S> static typename S::V apply(typename S::V a) { return S::bit_andnot(lanes_math::sign_mask<S>(), a); } };
+    struct wrap_op      { template <class S> static typename S::V apply(typename S::V t) { return lanes_math::wrap_kernel<S>(t); } };
+    struct sin_op       { template <class S> static typename S::V apply(typename S::V t) { typename S::V s, c; lanes_math::sincos_kernel<S>(t, s, c); return s; } };
+    struct cos_op       { template <class S> static typename S::V apply(typename S::V t) { typename S::V s, c; lanes_math::sincos_kernel<S>(t, s, c); return c; } };
+
+    struct real_op      { template <class S> static typename S::V apply(typename S::V re, typename S::V)  { return re; } };
+    struct imag_op      { template <class S> static typename S::V apply(typename S::V, typename S::V im)  { return im; } };
+    struct cabs_op      { template <class S> static typename S::V apply(typename S::V re, typename S::V im) { return S::sqrt(S::fmadd(re, re, S::mul(im, im))); } };
+    struct angle_op     { template <class S> static typename S::V apply(typename S::V re, typename S::V im) { return lanes_math::atan2_kernel<S>(im, re); } };
+
+    template <> struct lane_op<ublas::scalar_plus<float, float> >         : real_binary_lane_op<plus_op> {};
+    template <> struct lane_op<ublas::scalar_minus<float, float> >        : real_binary_lane_op<minus_op> {};
+    template <> struct lane_op<ublas::scalar_multiplies<float, float> >   : real_binary_lane_op<multiply_op> {};
+    template <> struct lane_op<ublas::scalar_divides<float, float> >      : real_binary_lane_op<divide_op> {};
+    template <> struct lane_op<max_functor<float, float> >                : real_binary_lane_op<max_op> {};
+    template <> struct lane_op<min_functor<float, float> >                : real_binary_lane_op<min_op> {};
+
+    template <> struct lane_op<ublas::scalar_negate<float> >              : real_unary_lane_op<negate_op> {};
+    template <> struct lane_op<abs_functor<float> >                       : real_unary_lane_op<fabs_op> {};
+    template <> struct lane_op<wrap_to_pi_functor<float> >                : real_unary_lane_op<wrap_op> {};
+    template <> struct lane_op<sin_functor<float> >                       : real_unary_lane_op<sin_op> {};
+    template <> struct lane_op<cos_functor<float> >                       : real_unary_lane_op<cos_op> {};
+
+    template <> struct lane_op<ublas::scalar_real<std::complex<float> > > : complex_to_real_lane_op<real_op> {};
+    template <> struct lane_op<ublas::scalar_imag<std::complex<float> > > : complex_to_real_lane_op<imag_op> {};
+    template <> struct lane_op<abs_functor<std::complex<float> > >        : complex_to_real_lane_op<cabs_op> {};
+    template <> struct lane_op<angle_functor<std::complex<float> > >      : complex_to_real_lane_op<angle_op> {};
+
+    template <> struct lane_op<complex_unary_functor<float> >
+    {
+        static const bool value = true;
+        template <class S, class L, class E>
+        static void load(const E &e, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            re = L::load(e, i);
+            im = S::set1(0.0f);
+        }
+    };
+
+    template <> struct lane_op<complex_functor<float, float> >
+    {
+        static const bool value = true;
+        template <class S, class L1, class L2, class E1, class E2>
+        static void load(const E1 &e1, const E2 &e2, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            re = L1::load(e1, i);
+            im = L2::load(e2, i);
+        }
+    };
+
+    template <> struct lane_op<pol2cart_functor<float, float> >
+    {
+        static const bool value = true;
+        template <class S, class L1, class L2, class E1, class E2>
+        static void load(const E1 &e1, const E2 &e2, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            typename S::V s, c, r = L1::load(e1, i);
+            lanes_math::sincos_kernel<S>(L2::load(e2, i), s, c);
+            re = S::mul(r, c);
+            im = S::mul(r, s);
+        }
+    };
+
+    //============ Expression nodes ===============================================
+    /* ublas keeps the operands of its own expressions private, so jv_bst has
+       its own nodes. They are ublas vector_expressions (size, operator(),
+       iterators), so = and bst::noalias accept them, and expose their
+       operands for the lane walk below. */
+
+    template <class N> struct node : public ublas::vector_expression<N> {};
+
+    template <class N, class V> struct node_types
+    {
+        typedef V value_type;
+        typedef V const_reference;
+        typedef V reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const N const_closure_type;
+        typedef const N closure_type;
+        typedef ublas::unknown_storage_tag storage_category;
+        typedef ublas::indexed_const_iterator<N, ublas::dense_random_access_iterator_tag> const_iterator;
+        typedef const_iterator iterator;
+    };
+
+    template <class E, class F>
+    class unary_node : public node<unary_node<E, F> >, public node_types<unary_node<E, F>, typename F::result_type>
+    {
+    public:
+        typedef typename E::const_closure_type expression_closure_type;
+        typedef node_types<unary_node, typename F::result_type> types;
+
+        explicit unary_node(const E &e) : e (e) {}
+
+        std::size_t size() const                                { return e.size(); }
+        typename types::const_reference operator() (std::size_t i) const { return F::apply(e(i)); }
+        typename types::const_iterator begin() const            { return typename types::const_iterator (*this, 0); }
+        typename types::const_iterator end() const              { return typename types::const_iterator (*this, size()); }
+        bool same_closure(const unary_node &other) const        { return this == &other; }
+
+        const expression_closure_type &expression() const       { return e; }
+
+    private:
+        expression_closure_type e;
+    };
+
+    template <class E1, class E2, class F>
+    class binary_node : public node<binary_node<E1, E2, F> >, public node_types<binary_node<E1, E2, F>, typename F::result_type>
+    {
+    public:
+        typedef typename E1::const_closure_type expression1_closure_type;
+        typedef typename E2::const_closure_type expression2_closure_type;
+        typedef node_types<binary_node, typename F::result_type> types;
+
+        binary_node(const E1 &e1, const E2 &e2) : e1 (e1), e2 (e2)
+        {
+            if (e1.size() != e2.size())
+                throw std::length_error("operands must be same size");
+        }
+
+        std::size_t size() const                                { return e1.size(); }
+        typename types::const_reference operator() (std::size_t i) const { return F::apply(e1(i), e2(i)); }
+        typename types::const_iterator begin() const            { return typename types::const_iterator (*this, 0); }
+        typename types::const_iterator end() const              { return typename types::const_iterator (*this, size()); }
+        bool same_closure(const binary_node &other) const       { return this == &other; }
+
+        const expression1_closure_type &expression1() const     { return e1; }
+        const expression2_closure_type &expression2() const     { return e2; }
+
+    private:
+        expression1_closure_type e1;
+        expression2_closure_type e2;
+    };
+
+    // e op a, for a scalar a
+    template <class E, class T, class F>
+    class scalar2_node : public node<scalar2_node<E, T, F> >, public node_types<scalar2_node<E, T, F>, typename F::result_type>
+    {
+    public:
+        typedef typename E::const_closure_type expression_closure_type;
+        typedef node_types<scalar2_node, typename F::result_type> types;
+
+        scalar2_node(const E &e, const T &a) : e (e), a (a) {}
+
+        std::size_t size() const                                { return e.size(); }
+        typename types::const_reference operator() (std::size_t i) const { return F::apply(e(i), a); }
+        typename types::const_iterator begin() const            { return typename types::const_iterator (*this, 0); }
+        typename types::const_iterator end() const              { return typename types::const_iterator (*this, size()); }
+        bool same_closure(const scalar2_node &other) const      { return this == &other; }
+
+        const expression_closure_type &expression() const       { return e; }
+        const T &scalar() const                                 { return a; }
+
+    private:
+        expression_closure_type e;
+        T a;
+    };
+
+    // a op e, for a scalar a
+    template <class T, class E, class F>
+    class scalar1_node : public node<scalar1_node<T, E, F> >, public node_types<scalar1_node<T, E, F>, typename F::result_type>
+    {
+    public:
+        typedef typename E::const_closure_type expression_closure_type;
+        typedef node_types<scalar1_node, typename F::result_type> types;
+
+        scalar1_node(const T &a, const E &e) : a (a), e (e) {}
+
+        std::size_t size() const                                { return e.size(); }
+        typename types::const_reference operator() (std::size_t i) const { return F::apply(a, e(i)); }
+        typename types::const_iterator begin() const            { return typename types::const_iterator (*this, 0); }
+        typename types::const_iterator end() const              { return typename types::const_iterator (*this, size()); }
+        bool same_closure(const scalar1_node &other) const      { return this == &other; }
+
+        const T &scalar() const                                 { return a; }
+        const expression_closure_type &expression() const       { return e; }
+
+    private:
+        T a;
+        expression_closure_type e;
+    };
+
+    //============ Expression walk ================================================
+    /* lanes<S, E>::load(e, i) gives bins i .. i + S::width - 1 of a float
+       expression, load(e, i, re, im) those of a complex<float> one. */
+
+    template <class S, class E, class Enable = void> struct lanes
+    {
+        // no lane version: gather bin by bin
+        static typename S::V load(const E &e, std::size_t i)
+        {
+            float x[S::width];
+            for (int j = 0; j < S::width; j++)
+                x[j] = static_cast<float>(e(i + j));
+            return S::load(x);
+        }
+        static void load(const E &e, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            float z[2 * S::width];
+            for (int j = 0; j < S::width; j++)
+            {
+                std::complex<float> u = e(i + j);
+                z[2*j] = u.real();
+                z[2*j + 1] = u.imag();
+            }
+            S::deinterleave(z, re, im);
+        }
+    };
+
+    // lanes of the closure an expression keeps of its operand E
+    template <class S, class E> struct operand_lanes
+    {
+        typedef lanes<S, typename std::remove_const<typename E::const_closure_type>::type> type;
+    };
+
+    template <class S, class A> struct lanes<S, ublas::vector<float, A> >
+    {
+        static typename S::V load(const ublas::vector<float, A> &v, std::size_t i)
+        {
+            return S::load(&v.data()[0] + i);
+        }
+    };
+
+    template <class S, class A> struct lanes<S, ublas::vector<std::complex<float>, A> >
+    {
+        static void load(const ublas::vector<std::complex<float>, A> &v, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            S::deinterleave(reinterpret_cast<const float*>(&v.data()[0]) + 2*i, re, im);
+        }
+    };
+
+    // vectors appear in expressions through their closure
+    template <class S, class V> struct lanes<S, ublas::vector_reference<V> >
+    {
+        typedef lanes<S, typename std::remove_const<V>::type> referred;
+        static typename S::V load(const ublas::vector_reference<V> &e, std::size_t i)
+        {
+            return referred::load(e.expression(), i);
+        }
+        static void load(const ublas::vector_reference<V> &e, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            referred::load(e.expression(), i, re, im);
+        }
+    };
+
+    template <class S> struct scalar_lanes
+    {
+        template <class T> static typename S::V load(const T &a, std::size_t)
+        {
+            return S::set1(static_cast<float>(a));
+        }
+    };
+
+    // jv_bst nodes, and ublas' own unary expressions (-x, real(z), ...)
+    template <class S, class X, class E, class F> struct unary_lanes
+    {
+        typedef typename operand_lanes<S, E>::type operand;
+        static typename S::V load(const X &e, std::size_t i)
+        {
+            return lane_op<F>::template load<S, operand>(e.expression(), i);
+        }
+        static void load(const X &e, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            lane_op<F>::template load<S, operand>(e.expression(), i, re, im);
+        }
+    };
+
+    template <class S, class E, class F>
+    struct lanes<S, unary_node<E, F>, typename std::enable_if<lane_op<F>::value>::type>
+        : unary_lanes<S, unary_node<E, F>, E, F> {};
+
+    template <class S, class E, class F>
+    struct lanes<S, ublas::vector_unary<E, F>, typename std::enable_if<lane_op<F>::value>::type>
+        : unary_lanes<S, ublas::vector_unary<E, F>, E, F> {};
+
+    template <class S, class E1, class E2, class F>
+    struct lanes<S, binary_node<E1, E2, F>, typename std::enable_if<lane_op<F>::value>::type>
+    {
+        typedef typename operand_lanes<S, E1>::type operand1;
+        typedef typename operand_lanes<S, E2>::type operand2;
+        static typename S::V load(const binary_node<E1, E2, F> &e, std::size_t i)
+        {
+            return lane_op<F>::template load<S, operand1, operand2>(e.expression1(), e.expression2(), i);
+        }
+        static void load(const binary_node<E1, E2, F> &e, std::size_t i, typename S::V &re, typename S::V &im)
+        {
+            lane_op<F>::template load<S, operand1, operand2>(e.expression1(), e.expression2(), i, re, im);
+        }
+    };
+
+    template <class S, class E, class T, class F>
+    struct lanes<S, scalar2_node<E, T, F>, typename std::enable_if<lane_op<F>::value>::type>
+    {
+        static typename S::V load(const scalar2_node<E, T, F> &e, std::size_t i)
+        {
+            return lane_op<F>::template load<S, typename operand_lanes<S, E>::type, scalar_lanes<S> >(e.expression(), e.scalar(), i);
+        }
+    };
+
+    template <class S, class T, class E, class F>
+    struct lanes<S, scalar1_node<T, E, F>, typename std::enable_if<lane_op<F>::value>::type>
+    {
+        static typename S::V load(const scalar1_node<T, E, F> &e, std::size_t i)
+        {
+            return lane_op<F>::template load<S, scalar_lanes<S>, typename operand_lanes<S, E>::type>(e.scalar(), e.expression(), i);
+        }
+    };
+
+    //============ Assignment =====================================================
+
+    template <class E>
+    void check_size(std::size_t size, const E &e)
+    {
+        if (e.size() != size)
+            throw std::length_error("expression and output must be same size");
+    }
+
+    template <class A, class E>
+    void assign(ublas::vector<float, A> &v, const E &e)
+    {
+        check_size(v.size(), e);
+        std::size_t n = v.size();
+        if (n == 0)
+            return;
+        std::size_t m = n - n % Lanes::width;
+        float *y = &v.data()[0];
+        for (std::size_t i = 0; i < m; i += Lanes::width)
+            Lanes::store(y + i, lanes<Lanes, E>::load(e, i));
+        for (std::size_t i = m; i < n; i++)
+            y[i] = lanes<lanes_math::Scalar, E>::load(e, i);
+    }
+
+    template <class A, class E>
+    void assign(ublas::vector<std::complex<float>, A> &v, const E &e)
+    {
+        check_size(v.size(), e);
+        std::size_t n = v.size();
+        if (n == 0)
+            return;
+        std::size_t m = n - n % Lanes::width;
+        float *z = reinterpret_cast<float*>(&v.data()[0]);
+        for (std::size_t i = 0; i < m; i += Lanes::width)
+        {
+            typename Lanes::V re, im;
+            lanes<Lanes, E>::load(e, i, re, im);
+            Lanes::interleave(z + 2*i, re, im);
+        }
+        for (std::size_t i = m; i < n; i++)
+            lanes<lanes_math::Scalar, E>::load(e, i, z[2*i], z[2*i + 1]);
+    }
+
+    // other value types: ublas, one bin at a time
+    template <class T, class A, class E>
+    void assign(ublas::vector<T, A> &v, const E &e)
+    {
+        check_size(v.size(), e);
+        ublas::noalias(v) = e;
+    }
+
+    template <class V> class lane_assigner
+    {
+    public:
+        explicit lane_assigner(V &v) : v (v) {}
+
+        template <class E> void operator= (const ublas::vector_expression<E> &e)
+        {
+            detail::assign(v, e());
+        }
+
+    private:
+        V &v;
+    };
+
+    //============ Operators ======================================================
+    /* +, -, * and / with at least one jv_bst node make jv_bst nodes; between
+       plain vectors they stay ublas' own. */
+
+    template <class E1, class E2> struct plus_node
+    {
+        typedef binary_node<E1, E2, ublas::scalar_plus<typename E1::value_type, typename E2::value_type> > type;
+    };
+    template <class E1, class E2> struct minus_node
+    {
+        typedef binary_node<E1, E2, ublas::scalar_minus<typename E1::value_type, typename E2::value_type> > type;
+    };
+
+    template <class E1, class E2> typename plus_node<E1, E2>::type operator+ (const node<E1> &a, const node<E2> &b)                  { return typename plus_node<E1, E2>::type (a(), b()); }
+    template <class E1, class E2> typename plus_node<E1, E2>::type operator+ (const node<E1> &a, const ublas::vector_expression<E2> &b) { return typename plus_node<E1, E2>::type (a(), b()); }
+    template <class E1, class E2> typename plus_node<E1, E2>::type operator+ (const ublas::vector_expression<E1> &a, const node<E2> &b) { return typename plus_node<E1, E2>::type (a(), b()); }
+
+    template <class E1, class E2> typename minus_node<E1, E2>::type operator- (const node<E1> &a, const node<E2> &b)                  { return typename minus_node<E1, E2>::type (a(), b()); }
+    template <class E1, class E2> typename minus_node<E1, E2>::type operator- (const node<E1> &a, const ublas::vector_expression<E2> &b) { return typename minus_node<E1, E2>::type (a(), b()); }
+    template <class E1, class E2> typename minus_node<E1, E2>::type operator- (const ublas::vector_expression<E1> &a, const node<E2> &b) { return typename minus_node<E1, E2>::type (a(), b()); }
+
+    template <class E>
+    unary_node<E, ublas::scalar_negate<typename E::value_type> > operator- (const node<E> &a)
+    {
+        return unary_node<E, ublas::scalar_negate<typename E::value_type> > (a());
+    }
+
+    template <class E, class T>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            scalar2_node<E, T, ublas::scalar_multiplies<typename E::value_type, T> > >::type
+    operator* (const node<E> &a, const T &b)
+    {
+        return scalar2_node<E, T, ublas::scalar_multiplies<typename E::value_type, T> > (a(), b);
+    }
+
+    template <class T, class E>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            scalar1_node<T, E, ublas::scalar_multiplies<T, typename E::value_type> > >::type
+    operator* (const T &a, const node<E> &b)
+    {
+        return scalar1_node<T, E, ublas::scalar_multiplies<T, typename E::value_type> > (a, b());
+    }
+
+    template <class E, class T>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            scalar2_node<E, T, ublas::scalar_divides<typename E::value_type, T> > >::type
+    operator/ (const node<E> &a, const T &b)
+    {
+        return scalar2_node<E, T, ublas::scalar_divides<typename E::value_type, T> > (a(), b);
+    }
+}
+
+    /* v = e in one pass, a SIMD width of bins at a time */
+    template <class T, class A>
+    detail::lane_assigner<boost::numeric::ublas::vector<T, A> > noalias(boost::numeric::ublas::vector<T, A> &v)
+    {
+        return detail::lane_assigner<boost::numeric::ublas::vector<T, A> > (v);
+    }
+
+    //============ Lazy operations ================================================
+
+    template <class E, class T>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            detail::scalar2_node<E, T, boost::numeric::ublas::scalar_plus<typename E::value_type, T> > >::type
+    add(const boost::numeric::ublas::vector_expression<E> &x, const T &a)
+    {
+        return detail::scalar2_node<E, T, boost::numeric::ublas::scalar_plus<typename E::value_type, T> > (x(), a);
+    }
+
+    template <class E1, class E2>
+    typename detail::plus_node<E1, E2>::type add(const boost::numeric::ublas::vector_expression<E1> &x, const boost::numeric::ublas::vector_expression<E2> &y)
+    {
+        return typename detail::plus_node<E1, E2>::type (x(), y());
+    }
+
+    template <class E1, class E2>
+    detail::binary_node<E1, E2, boost::numeric::ublas::scalar_multiplies<typename E1::value_type, typename E2::value_type> >
+    element_prod(const boost::numeric::ublas::vector_expression<E1> &x, const boost::numeric::ublas::vector_expression<E2> &y)
+    {
+        return detail::binary_node<E1, E2, boost::numeric::ublas::scalar_multiplies<typename E1::value_type, typename E2::value_type> > (x(), y());
+    }
+
+    template <class E, class T>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            detail::scalar2_node<E, T, detail::max_functor<typename E::value_type, T> > >::type
+    max(const boost::numeric::ublas::vector_expression<E> &x, const T &a)
+    {
+        return detail::scalar2_node<E, T, detail::max_functor<typename E::value_type, T> > (x(), a);
+    }
+
+    template <class E1, class E2>
+    detail::binary_node<E1, E2, detail::max_functor<typename E1::value_type, typename E2::value_type> >
+    max(const boost::numeric::ublas::vector_expression<E1> &x, const boost::numeric::ublas::vector_expression<E2> &y)
+    {
+        return detail::binary_node<E1, E2, detail::max_functor<typename E1::value_type, typename E2::value_type> > (x(), y());
+    }
+
+    template <class E, class T>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            detail::scalar2_node<E, T, detail::min_functor<typename E::value_type, T> > >::type
+    min(const boost::numeric::ublas::vector_expression<E> &x, const T &a)
+    {
+        return detail::scalar2_node<E, T, detail::min_functor<typename E::value_type, T> > (x(), a);
+    }
+
+    template <class E1, class E2>
+    detail::binary_node<E1, E2, detail::min_functor<typename E1::value_type, typename E2::value_type> >
+    min(const boost::numeric::ublas::vector_expression<E1> &x, const boost::numeric::ublas::vector_expression<E2> &y)
+    {
+        return detail::binary_node<E1, E2, detail::min_functor<typename E1::value_type, typename E2::value_type> > (x(), y());
+    }
+
+    template <class E>
+    detail::unary_node<E, boost::numeric::ublas::scalar_real<typename E::value_type> >
+    real(const boost::numeric::ublas::vector_expression<E> &z)
+    {
+        return detail::unary_node<E, boost::numeric::ublas::scalar_real<typename E::value_type> > (z());
+    }
+
+    template <class E>
+    detail::unary_node<E, boost::numeric::ublas::scalar_imag<typename E::value_type> >
+    imag(const boost::numeric::ublas::vector_expression<E> &z)
+    {
+        return detail::unary_node<E, boost::numeric::ublas::scalar_imag<typename E::value_type> > (z());
+    }
+
+    template <class E>
+    detail::unary_node<E, detail::abs_functor<typename E::value_type> >
+    abs(const boost::numeric::ublas::vector_expression<E> &z)
+    {
+        return detail::unary_node<E, detail::abs_functor<typename E::value_type> > (z());
+    }
+
+    template <class E>
+    detail::unary_node<E, detail::angle_functor<typename E::value_type> >
+    angle(const boost::numeric::ublas::vector_expression<E> &z)
+    {
+        return detail::unary_node<E, detail::angle_functor<typename E::value_type> > (z());
+    }
+
+    template <class E, class T>
+    typename std::enable_if<std::is_convertible<T, typename E::value_type>::value,
+                            detail::scalar2_node<E, T, detail::pow_functor<typename E::value_type, T> > >::type
+    pow(const boost::numeric::ublas::vector_expression<E> &x, const T &p)
+    {
+        return detail::scalar2_node<E, T, detail::pow_functor<typename E::value_type, T> > (x(), p);
+    }
+
+    template <class E>
+    detail::unary_node<E, detail::sin_functor<typename E::value_type> >
+    sin(const boost::numeric::ublas::vector_expression<E> &t)
+    {
+        return detail::unary_node<E, detail::sin_functor<typename E::value_type> > (t());
+    }
+
+    template <class E>
+    detail::unary_node<E, detail::cos_functor<typename E::value_type> >
+    cos(const boost::numeric::ublas::vector_expression<E> &t)
+    {
+        return detail::unary_node<E, detail::cos_functor<typename E::value_type> > (t());
+    }
+
+    template <class E>
+    detail::unary_node<E, detail::wrap_to_pi_functor<typename E::value_type> >
+    wrap_to_pi(const boost::numeric::ublas::vector_expression<E> &t)
+    {
+        return detail::unary_node<E, detail::wrap_to_pi_functor<typename E::value_type> > (t());
+    }
+
+    template <class E>
+    detail::unary_node<E, detail::complex_unary_functor<typename E::value_type> >
+    complex(const boost::numeric::ublas::vector_expression<E> &r)
+    {
+        return detail::unary_node<E, detail::complex_unary_functor<typename E::value_type> > (r());
+    }
+
+    template <class E1, class E2>
+    detail::binary_node<E1, E2, detail::complex_functor<typename E1::value_type, typename E2::value_type> >
+    complex(const boost::numeric::ublas::vector_expression<E1> &r, const boost::numeric::ublas::vector_expression<E2> &i)
+    {
+        return detail::binary_node<E1, E2, detail::complex_functor<typename E1::value_type, typename E2::value_type> > (r(), i());
+    }
+
+    template <class E1, class E2>
+    detail::binary_node<E1, E2, detail::pol2cart_functor<typename E1::value_type, typename E2::value_type> >
+    pol2cart(const boost::numeric::ublas::vector_expression<E1> &r, const boost::numeric::ublas::vector_expression<E2> &p)
+    {
+        return detail::binary_node<E1, E2, detail::pol2cart_functor<typename E1::value_type, typename E2::value_type> > (r(), p());
+    }
+};
@@ -10,35 +10,97 @@
 
 #include "VectorOperations2.h"
 
+#include "../FastMath/FastMath.h"
+
+/* element loops behind abs, angle, sin, cos and wrap_to_pi: float goes
+   through the fast_math kernels, other types through std:: */
+namespace
+{
+    template <typename T> void abs_n(const std::complex<T> *z, T *v, int n)
+    {
+        for (int k = 0; k < n; k++)
+            v[k] = std::abs(z[k]);
+    }
+    void abs_n(const std::complex<float> *z, float *v, int n)
+    {
+        fast_math::car2pol(z, v, nullptr, n);
+    }
+    
+    template <typename T> void angle_n(const std::complex<T> *z, T *v, int n)
+    {
+        for (int k = 0; k < n; k++)
+            v[k] = std::arg(z[k]);
+    }
+    void angle_n(const std::complex<float> *z, float *v, int n)
+    {
+        fast_math::car2pol(z, nullptr, v, n);
+    }
+    
+    template <typename T> void sin_n(const T *t, T *y, int n)
+    {
+        for (int k = 0; k < n; k++)
+            y[k] = std::sin(t[k]);
+    }
+    void sin_n(const float *t, float *y, int n)
+    {
+        fast_math::sin(t, y, n);
+    }
+    
+    template <typename T> void cos_n(const T *t, T *y, int n)
+    {
+        for (int k = 0; k < n; k++)
+            y[k] = std::cos(t[k]);
+    }
+    void cos_n(const float *t, float *y, int n)
+    {
+        fast_math::cos(t, y, n);
+    }
+    
+    template <typename T> void wrap_to_pi_n(const T *t, T *y, int n)
+    {
+        for (int k = 0; k < n; k++)
+            y[k] = t[k] - (2.0 * M_PI * std::floor((t[k] + M_PI) / (2.0 * M_PI)));
+    }
+    void wrap_to_pi_n(const float *t, float *y, int n)
+    {
+        fast_math::wrap_to_pi(t, y, n);
+    }
+    
+    /* size a caller-owned output: only allocates if the size is wrong */
+    template <typename V> void fit(V &y, std::size_t size)
+    {
+        if (y.size() != size)
+            y.resize(size, false);
+    }
+}
+
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::add(boost::numeric::ublas::vector<T> x, T a)
+void jv_bst::add(const boost::numeric::ublas::vector<T> &x, T a, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (x.size());
+    fit(y, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         y(n) = x(n) + a;
     }
-    return y;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::max(boost::numeric::ublas::vector<T> x, T a)
+void jv_bst::max(const boost::numeric::ublas::vector<T> &x, T a, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (x.size());
+    fit(y, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         if (x(n) > a)
             y(n) = x(n);
         else
-            x(n) = a;
+            y(n) = a;
     }
-    return y;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::max(boost::numeric::ublas::vector<T> x, boost::numeric::ublas::vector<T> y)
+void jv_bst::max(const boost::numeric::ublas::vector<T> &x, const boost::numeric::ublas::vector<T> &y, boost::numeric::ublas::vector<T> &w)
 {
-    boost::numeric::ublas::vector<T> w (x.size());
+    fit(w, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         if (x(n) > y(n))
@@ -46,27 +108,25 @@ boost::numeric::ublas::vector<T> jv_bst::max(boost::numeric::ublas::vector<T> x,
         else
             w(n) = y(n);
     }
-    return y;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::min(boost::numeric::ublas::vector<T> x, T a)
+void jv_bst::min(const boost::numeric::ublas::vector<T> &x, T a, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (x.size());
+    fit(y, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         if (x(n) < a)
             y(n) = x(n);
         else
-            x(n) = a;
+            y(n) = a;
     }
-    return y;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::min(boost::numeric::ublas::vector<T> x, boost::numeric::ublas::vector<T> y)
+void jv_bst::min(const boost::numeric::ublas::vector<T> &x, const boost::numeric::ublas::vector<T> &y, boost::numeric::ublas::vector<T> &w)
 {
-    boost::numeric::ublas::vector<T> w (x.size());
+    fit(w, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         if (x(n) < y(n))
@@ -74,11 +134,10 @@ boost::numeric::ublas::vector<T> jv_bst::min(boost::numeric::ublas::vector<T> x,
         else
             w(n) = y(n);
     }
-    return y;
 }
 
 template <typename T>
-T jv_bst::mean(boost::numeric::ublas::vector<T> x)
+T jv_bst::mean(const boost::numeric::ublas::vector<T> &x)
 {
     T mu = T();
     for (int n = 0; n < x.size(); n++)
@@ -90,170 +149,167 @@ T jv_bst::mean(boost::numeric::ublas::vector<T> x)
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::real(boost::numeric::ublas::vector<std::complex<T> > z)
+void jv_bst::real(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &r)
 {
-    boost::numeric::ublas::vector<T> r (z.size());
+    fit(r, z.size());
     for (int n = 0; n < z.size(); n++)
     {
         r(n) = z(n).real();
     }
-    return r;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::imag(boost::numeric::ublas::vector<std::complex<T> > z)
+void jv_bst::imag(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &i)
 {
-    boost::numeric::ublas::vector<T> i (z.size());
+    fit(i, z.size());
     for (int n = 0; n < z.size(); n++)
     {
         i(n) = z(n).imag();
     }
-    return i;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::abs(boost::numeric::ublas::vector<std::complex<T> > z)
+void jv_bst::abs(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &v)
 {
-    boost::numeric::ublas::vector<T> v (z.size());
-    for (int n = 0; n < z.size(); n++)
-    {
-        v(n) = abs(z(n));
-    }
-    return v;
+    fit(v, z.size());
+    if (z.size() > 0)
+        abs_n(&z(0), &v(0), static_cast<int>(z.size()));
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::abs(boost::numeric::ublas::vector<T> x)
+void jv_bst::abs(const boost::numeric::ublas::vector<T> &x, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (x.size());
+    fit(y, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         y(n) = std::abs(x(n));
     }
-    return x;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::angle(boost::numeric::ublas::vector<std::complex<T> > z)
+void jv_bst::angle(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &v)
 {
-    boost::numeric::ublas::vector<T> v (z.size());
-    for (int n = 0; n < z.size(); n++)
-    {
-        v(n) = std::arg(z(n));
-    }
-    return v;
+    fit(v, z.size());
+    if (z.size() > 0)
+        angle_n(&z(0), &v(0), static_cast<int>(z.size()));
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::pow(boost::numeric::ublas::vector<T> x, T p)
+void jv_bst::pow(const boost::numeric::ublas::vector<T> &x, T p, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (x.size());
+    fit(y, x.size());
     for (int n = 0; n < x.size(); n++)
     {
         y(n) = std::pow(x(n), p);
     }
-    return y;
 }
 
-template <typename T> boost::numeric::ublas::vector<T> jv_bst::sin(boost::numeric::ublas::vector<T> t)
+template <typename T> void jv_bst::sin(const boost::numeric::ublas::vector<T> &t, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (t.size());
-    for (int n = 0; n < t.size(); n++)
-    {
-        y(n) = std::sin(t(n));
-    }
-    return y;
+    fit(y, t.size());
+    if (t.size() > 0)
+        sin_n(&t(0), &y(0), static_cast<int>(t.size()));
 }
 
-template <typename T> boost::numeric::ublas::vector<T> jv_bst::cos(boost::numeric::ublas::vector<T> t)
+template <typename T> void jv_bst::cos(const boost::numeric::ublas::vector<T> &t, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (t.size());
-    for (int n = 0; n < t.size(); n++)
-    {
-        y(n) = std::cos(t(n));
-    }
-    return y;
+    fit(y, t.size());
+    if (t.size() > 0)
+        cos_n(&t(0), &y(0), static_cast<int>(t.size()));
 }
 
-template <typename T> boost::numeric::ublas::vector<T> jv_bst::wrap_to_pi(boost::numeric::ublas::vector<T> t)
+template <typename T> void jv_bst::wrap_to_pi(const boost::numeric::ublas::vector<T> &t, boost::numeric::ublas::vector<T> &y)
 {
-    boost::numeric::ublas::vector<T> y (t.size());
-    for (int n = 0; n < t.size(); n++)
-    {
-        y(n) = t(n) - (2.0 * M_PI * std::floor((t(n) + M_PI) / (2.0 * M_PI)));
-    }
+    fit(y, t.size());
+    if (t.size() > 0)
+        wrap_to_pi_n(&t(0), &y(0), static_cast<int>(t.size()));
+}
+
+template <typename T>
+boost::numeric::ublas::vector<T> jv_bst::zp(const boost::numeric::ublas::vector<T> &x, int len)
+{
+    boost::numeric::ublas::vector<T> y (x.size() + len);
+    zp(x, len, y);
     return y;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<T> jv_bst::zp(boost::numeric::ublas::vector<T> x, int len)
+void jv_bst::zp(const boost::numeric::ublas::vector<T> &x, int len, boost::numeric::ublas::vector<T> &y)
 {
-    /* zero-pad */
-    boost::numeric::ublas::vector<T> y (x.size() + len, 0.0);
+    /* zero-pad; y must not be x */
+    fit(y, x.size() + len);
     for (int n = 0; n < x.size(); n++)
     {
         y(n) = x(n);
     }
+    for (int n = x.size(); n < y.size(); n++)
+    {
+        y(n) = T();
+    }
+}
+
+template <typename T> boost::numeric::ublas::vector<std::complex<T> > jv_bst::zp(const boost::numeric::ublas::vector<std::complex<T> > &z, int len)
+{
+    boost::numeric::ublas::vector<std::complex<T> > y (z.size() + len);
+    zp(z, len, y);
     return y;
 }
 
-template <typename T> boost::numeric::ublas::vector<std::complex<T> > jv_bst::zp(boost::numeric::ublas::vector<std::complex<T> > z, int len)
+template <typename T> void jv_bst::zp(const boost::numeric::ublas::vector<std::complex<T> > &z, int len, boost::numeric::ublas::vector<std::complex<T> > &y)
 {
-    /* zero-pad */
-    boost::numeric::ublas::vector<std::complex<T> > y (z.size() + len, 0.0);
+    /* zero-pad; y must not be z */
+    fit(y, z.size() + len);
     for (int n = 0; n < z.size(); n++)
     {
         y(n) = z(n);
     }
-    return y;
+    for (int n = z.size(); n < y.size(); n++)
+    {
+        y(n) = std::complex<T>();
+    }
 }
 
 template <typename T>
-boost::numeric::ublas::vector<std::complex<T> > jv_bst::complex(boost::numeric::ublas::vector<T> r)
+void jv_bst::complex(const boost::numeric::ublas::vector<T> &r, boost::numeric::ublas::vector<std::complex<T> > &z)
 {
     /* takes real vector and outputs complex vector */
-    boost::numeric::ublas::vector<std::complex<T> > z (r.size());
+    fit(z, r.size());
     for (int n = 0; n < z.size(); n++)
     {
         z(n) = r(n);
     }
-    return z;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<std::complex<T> > jv_bst::complex(boost::numeric::ublas::vector<T> r, boost::numeric::ublas::vector<T> i)
+void jv_bst::complex(const boost::numeric::ublas::vector<T> &r, const boost::numeric::ublas::vector<T> &i, boost::numeric::ublas::vector<std::complex<T> > &z)
 {
-    /* takes real vector and outputs complex vector */
-    boost::numeric::ublas::vector<std::complex<T> > z (r.size());
-    std::complex<T> u;
+    /* takes real and imaginary vectors and outputs complex vector */
+    fit(z, r.size());
     for (int n = 0; n < z.size(); n++)
     {
-        u = std::complex<T>(r(n), i(n));
-        z(n) = u;
+        z(n) = std::complex<T>(r(n), i(n));
     }
-    return z;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<std::complex<T> > jv_bst::pol2cart(boost::numeric::ublas::vector<T> r, boost::numeric::ublas::vector<T> p)
+void jv_bst::pol2cart(const boost::numeric::ublas::vector<T> &r, const boost::numeric::ublas::vector<T> &p, boost::numeric::ublas::vector<std::complex<T> > &z)
 {
     /* convert magnitude and phase vectors to cartesian complex vector */
     
     if (r.size() != p.size())
         throw std::length_error("r and p must be same size");
     
-    boost::numeric::ublas::vector<std::complex<T> > z (r.size(), T());
+    fit(z, r.size());
     for (int n = 0; n < z.size(); n++)
     {
         T re = r(n) * std::cos(p(n));
         T im = r(n) * std::sin(p(n));
         z(n) = std::complex<T> (re, im);
     }
-    return z;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<std::complex<T> > jv_bst::fft(boost::numeric::ublas::vector<T> r, kiss_fft_cfg dir)
+boost::numeric::ublas::vector<std::complex<T> > jv_bst::fft(const boost::numeric::ublas::vector<T> &r, kiss_fft_cfg dir)
 {
     /* wrapper for kiss_fft */
     
@@ -276,26 +332,22 @@ boost::numeric::ublas::vector<std::complex<T> > jv_bst::fft(boost::numeric::ubla
         buffer(n).i = 0.0;
     }
     
-    // transform
-    kiss_fft(dir, buffer.data().begin(), buffer.data().begin());
+    // transform out of place (in place makes kiss_fft allocate a tmpbuf)
+    boost::numeric::ublas::vector<kiss_fft_cpx> transformed (dir->nfft);
+    kiss_fft(dir, buffer.data().begin(), transformed.data().begin());
     
-    // copy to result
-    for (int n = 0; n < buffer.size(); n++)
+    // copy to result, rescaling if inverse
+    T scale = dir->inverse ? (1.0 / static_cast<T>(dir->nfft)) : 1.0;
+    for (int n = 0; n < transformed.size(); n++)
     {
-        result(n) = std::complex<T>(static_cast<T>(buffer(n).r), static_cast<T>(buffer(n).i));
-    }
-    
-    // rescale if inverse
-    if (dir->inverse)
-    {
-        result *= (1.0 / static_cast<T>(dir->nfft));
+        result(n) = std::complex<T>(static_cast<T>(transformed(n).r) * scale, static_cast<T>(transformed(n).i) * scale);
     }
     
     return result;
 }
 
 template <typename T>
-boost::numeric::ublas::vector<std::complex<T> > jv_bst::fft(boost::numeric::ublas::vector<std::complex<T> > z, kiss_fft_cfg dir)
+boost::numeric::ublas::vector<std::complex<T> > jv_bst::fft(const boost::numeric::ublas::vector<std::complex<T> > &z, kiss_fft_cfg dir)
 {
     /* wrapper for kiss_fft */
     
@@ -318,25 +370,87 @@ boost::numeric::ublas::vector<std::complex<T> > jv_bst::fft(boost::numeric::ubla
         buffer(n).i = 0.0;
     }
     
+    // transform out of place (in place makes kiss_fft allocate a tmpbuf)
+    boost::numeric::ublas::vector<kiss_fft_cpx> transformed (dir->nfft);
+    kiss_fft(dir, buffer.data().begin(), transformed.data().begin());
+    
+    // copy to result, rescaling if inverse
+    T scale = dir->inverse ? (1.0 / static_cast<T>(dir->nfft)) : 1.0;
+    for (int n = 0; n < transformed.size(); n++)
+    {
+        result(n) = std::complex<T>(static_cast<T>(transformed(n).r) * scale, static_cast<T>(transformed(n).i) * scale);
+    }
+    
+    return result;
+}
+
+template <typename T>
+boost::numeric::ublas::vector<std::complex<T> > jv_bst::rfft(const boost::numeric::ublas::vector<T> &r, kiss_fftr_cfg dir)
+{
+    /* wrapper for kiss_fftr: r must be of (even) length n_fft */
+    
+    if (r.size() % 2 != 0)
+        throw std::length_error("vector size must be even");
+    
+    int num_bins = r.size() / 2 + 1;
+    
+    // result
+    boost::numeric::ublas::vector<std::complex<T> > result (num_bins);
+    // use kiss_fft types
+    boost::numeric::ublas::vector<kiss_fft_scalar> buffer (r.size());
+    boost::numeric::ublas::vector<kiss_fft_cpx> spectrum (num_bins);
+    for (int n = 0; n < r.size(); n++)
+    {
+        buffer(n) = r(n);
+    }
+    
     // transform
-    kiss_fft(dir, buffer.data().begin(), buffer.data().begin());
+    kiss_fftr(dir, buffer.data().begin(), spectrum.data().begin());
     
     // copy to result
-    for (int n = 0; n < buffer.size(); n++)
+    for (int k = 0; k < num_bins; k++)
     {
-        result(n) = std::complex<T>(static_cast<T>(buffer(n).r), static_cast<T>(buffer(n).i));
+        result(k) = std::complex<T>(static_cast<T>(spectrum(k).r), static_cast<T>(spectrum(k).i));
     }
     
-    // rescale if inverse
-    if (dir->inverse)
+    return result;
+}
+
+template <typename T>
+boost::numeric::ublas::vector<T> jv_bst::irfft(const boost::numeric::ublas::vector<std::complex<T> > &z, kiss_fftr_cfg dir)
+{
+    /* wrapper for kiss_fftri: z is a half-spectrum of length n_fft/2 + 1 */
+    
+    if (z.size() < 2)
+        throw std::length_error("half-spectrum must have at least 2 bins");
+    
+    int n_fft = 2 * (z.size() - 1);
+    
+    // result
+    boost::numeric::ublas::vector<T> result (n_fft);
+    // use kiss_fft types
+    boost::numeric::ublas::vector<kiss_fft_cpx> spectrum (z.size());
+    boost::numeric::ublas::vector<kiss_fft_scalar> buffer (n_fft);
+    for (int k = 0; k < z.size(); k++)
+    {
+        spectrum(k).r = z(k).real();
+        spectrum(k).i = z(k).imag();
+    }
+    
+    // transform
+    kiss_fftri(dir, spectrum.data().begin(), buffer.data().begin());
+    
+    // copy to result and rescale
+    T scale = 1.0 / static_cast<T>(n_fft);
+    for (int n = 0; n < n_fft; n++)
     {
-        result *= (1.0 / static_cast<T>(dir->nfft));
+        result(n) = static_cast<T>(buffer(n)) * scale;
     }
     
     return result;
 }
 
-template <typename T> bool jv_bst::has_nan(boost::numeric::ublas::vector<T> x)
+template <typename T> bool jv_bst::has_nan(const boost::numeric::ublas::vector<T> &x)
 {
     /* Return true if x contains nan value(s) */
     
@@ -348,7 +462,7 @@ template <typename T> bool jv_bst::has_nan(boost::numeric::ublas::vector<T> x)
     return false;
 }
 
-template <typename T> bool jv_bst::has_inf(boost::numeric::ublas::vector<T> x)
+template <typename T> bool jv_bst::has_inf(const boost::numeric::ublas::vector<T> &x)
 {
     for (int n = 0; n < x.size(); n++)
     {
@@ -359,52 +473,61 @@ template <typename T> bool jv_bst::has_inf(boost::numeric::ublas::vector<T> x)
 }
 
 
-template boost::numeric::ublas::vector<float>                   jv_bst::add(boost::numeric::ublas::vector<float> x, float a);
-template boost::numeric::ublas::vector<float>                   jv_bst::max(boost::numeric::ublas::vector<float> x, float a);
-template boost::numeric::ublas::vector<float>                   jv_bst::max(boost::numeric::ublas::vector<float> x, boost::numeric::ublas::vector<float> y);
-template boost::numeric::ublas::vector<float>                   jv_bst::min(boost::numeric::ublas::vector<float> x, float a);
-template boost::numeric::ublas::vector<float>                   jv_bst::min(boost::numeric::ublas::vector<float> x, boost::numeric::ublas::vector<float> y);
-template float                                                  jv_bst::mean(boost::numeric::ublas::vector<float> x);
-template boost::numeric::ublas::vector<float>                   jv_bst::real(boost::numeric::ublas::vector<std::complex<float> > z);
-template boost::numeric::ublas::vector<float>                   jv_bst::imag(boost::numeric::ublas::vector<std::complex<float> > z);
-template boost::numeric::ublas::vector<float>                   jv_bst::abs(boost::numeric::ublas::vector<std::complex<float> > z);
-template boost::numeric::ublas::vector<float>                   jv_bst::abs(boost::numeric::ublas::vector<float> x);
-template boost::numeric::ublas::vector<float>                   jv_bst::angle(boost::numeric::ublas::vector<std::complex<float> > z);
-template boost::numeric::ublas::vector<float>                   jv_bst::pow(boost::numeric::ublas::vector<float> x, float p);
-template boost::numeric::ublas::vector<float>                   jv_bst::sin(boost::numeric::ublas::vector<float> t);
-template boost::numeric::ublas::vector<float>                   jv_bst::cos(boost::numeric::ublas::vector<float> t);
-template boost::numeric::ublas::vector<float>                   jv_bst::wrap_to_pi(boost::numeric::ublas::vector<float> t);
-template boost::numeric::ublas::vector<float>                   jv_bst::zp(boost::numeric::ublas::vector<float> x, int len);
-template boost::numeric::ublas::vector<std::complex<float> >    jv_bst::zp(boost::numeric::ublas::vector<std::complex<float> > z, int len);
-template boost::numeric::ublas::vector<std::complex<float> >    jv_bst::complex(boost::numeric::ublas::vector<float> r);
-template boost::numeric::ublas::vector<std::complex<float> >    jv_bst::complex(boost::numeric::ublas::vector<float> r, boost::numeric::ublas::vector<float> i);
-template boost::numeric::ublas::vector<std::complex<float> >    jv_bst::pol2cart(boost::numeric::ublas::vector<float> r, boost::numeric::ublas::vector<float> p);
-template boost::numeric::ublas::vector<std::complex<float> >    jv_bst::fft(boost::numeric::ublas::vector<float> r, kiss_fft_cfg dir);
-template boost::numeric::ublas::vector<std::complex<float> >    jv_bst::fft(boost::numeric::ublas::vector<std::complex<float> > z, kiss_fft_cfg dir);
-template bool                                                   jv_bst::has_nan(boost::numeric::ublas::vector<float> x);
-template bool                                                   jv_bst::has_inf(boost::numeric::ublas::vector<float> x);
-
-template boost::numeric::ublas::vector<double>                  jv_bst::add(boost::numeric::ublas::vector<double> x, double a);
-template boost::numeric::ublas::vector<double>                  jv_bst::max(boost::numeric::ublas::vector<double> x, double a);
-template boost::numeric::ublas::vector<double>                  jv_bst::max(boost::numeric::ublas::vector<double> x, boost::numeric::ublas::vector<double> y);
-template boost::numeric::ublas::vector<double>                  jv_bst::min(boost::numeric::ublas::vector<double> x, double a);
-template boost::numeric::ublas::vector<double>                  jv_bst::min(boost::numeric::ublas::vector<double> x, boost::numeric::ublas::vector<double> y);
-template double                                                 jv_bst::mean(boost::numeric::ublas::vector<double> x);
-template boost::numeric::ublas::vector<double>                  jv_bst::real(boost::numeric::ublas::vector<std::complex<double> > z);
-template boost::numeric::ublas::vector<double>                  jv_bst::imag(boost::numeric::ublas::vector<std::complex<double> > z);
-template boost::numeric::ublas::vector<double>                  jv_bst::abs(boost::numeric::ublas::vector<std::complex<double> > z);
-template boost::numeric::ublas::vector<double>                  jv_bst::abs(boost::numeric::ublas::vector<double> x);
-template boost::numeric::ublas::vector<double>                  jv_bst::angle(boost::numeric::ublas::vector<std::complex<double> > z);
-template boost::numeric::ublas::vector<double>                  jv_bst::pow(boost::numeric::ublas::vector<double> x, double p);
-template boost::numeric::ublas::vector<double>                  jv_bst::sin(boost::numeric::ublas::vector<double> t);
-template boost::numeric::ublas::vector<double>                  jv_bst::cos(boost::numeric::ublas::vector<double> t);
-template boost::numeric::ublas::vector<double>                  jv_bst::wrap_to_pi(boost::numeric::ublas::vector<double> t);
-template boost::numeric::ublas::vector<double>                  jv_bst::zp(boost::numeric::ublas::vector<double> x, int len);
-template boost::numeric::ublas::vector<std::complex<double> >   jv_bst::zp(boost::numeric::ublas::vector<std::complex<double> > z, int len);
-template boost::numeric::ublas::vector<std::complex<double> >   jv_bst::complex(boost::numeric::ublas::vector<double> r);
-template boost::numeric::ublas::vector<std::complex<double> >   jv_bst::complex(boost::numeric::ublas::vector<double> r, boost::numeric::ublas::vector<double> i);
-template boost::numeric::ublas::vector<std::complex<double> >   jv_bst::pol2cart(boost::numeric::ublas::vector<double> r, boost::numeric::ublas::vector<double> p);
-template boost::numeric::ublas::vector<std::complex<double> >   jv_bst::fft(boost::numeric::ublas::vector<double> r, kiss_fft_cfg dir);
-template boost::numeric::ublas::vector<std::complex<double> >   jv_bst::fft(boost::numeric::ublas::vector<std::complex<double> > z, kiss_fft_cfg dir);
-template bool                                                   jv_bst::has_nan(boost::numeric::ublas::vector<double> x);
-template bool                                                   jv_bst::has_inf(boost::numeric::ublas::vector<double> x);
+
+template void                                                     jv_bst::add(const boost::numeric::ublas::vector<float> &x, float a, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::max(const boost::numeric::ublas::vector<float> &x, float a, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::max(const boost::numeric::ublas::vector<float> &x, const boost::numeric::ublas::vector<float> &y, boost::numeric::ublas::vector<float> &w);
+template void                                                     jv_bst::min(const boost::numeric::ublas::vector<float> &x, float a, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::min(const boost::numeric::ublas::vector<float> &x, const boost::numeric::ublas::vector<float> &y, boost::numeric::ublas::vector<float> &w);
+template float                                                    jv_bst::mean(const boost::numeric::ublas::vector<float> &x);
+template void                                                     jv_bst::real(const boost::numeric::ublas::vector<std::complex<float> > &z, boost::numeric::ublas::vector<float> &r);
+template void                                                     jv_bst::imag(const boost::numeric::ublas::vector<std::complex<float> > &z, boost::numeric::ublas::vector<float> &i);
+template void                                                     jv_bst::abs(const boost::numeric::ublas::vector<std::complex<float> > &z, boost::numeric::ublas::vector<float> &v);
+template void                                                     jv_bst::abs(const boost::numeric::ublas::vector<float> &x, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::angle(const boost::numeric::ublas::vector<std::complex<float> > &z, boost::numeric::ublas::vector<float> &v);
+template void                                                     jv_bst::pow(const boost::numeric::ublas::vector<float> &x, float p, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::sin(const boost::numeric::ublas::vector<float> &t, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::cos(const boost::numeric::ublas::vector<float> &t, boost::numeric::ublas::vector<float> &y);
+template void                                                     jv_bst::wrap_to_pi(const boost::numeric::ublas::vector<float> &t, boost::numeric::ublas::vector<float> &y);
+template boost::numeric::ublas::vector<float>                     jv_bst::zp(const boost::numeric::ublas::vector<float> &x, int len);
+template void                                                     jv_bst::zp(const boost::numeric::ublas::vector<float> &x, int len, boost::numeric::ublas::vector<float> &y);
+template boost::numeric::ublas::vector<std::complex<float> > jv_bst::zp(const boost::numeric::ublas::vector<std::complex<float> > &z, int len);
+template void                                                     jv_bst::zp(const boost::numeric::ublas::vector<std::complex<float> > &z, int len, boost::numeric::ublas::vector<std::complex<float> > &y);
+template void                                                     jv_bst::complex(const boost::numeric::ublas::vector<float> &r, boost::numeric::ublas::vector<std::complex<float> > &z);
+template void                                                     jv_bst::complex(const boost::numeric::ublas::vector<float> &r, const boost::numeric::ublas::vector<float> &i, boost::numeric::ublas::vector<std::complex<float> > &z);
+template void                                                     jv_bst::pol2cart(const boost::numeric::ublas::vector<float> &r, const boost::numeric::ublas::vector<float> &p, boost::numeric::ublas::vector<std::complex<float> > &z);
+template boost::numeric::ublas::vector<std::complex<float> > jv_bst::fft(const boost::numeric::ublas::vector<float> &r, kiss_fft_cfg dir);
+template boost::numeric::ublas::vector<std::complex<float> > jv_bst::fft(const boost::numeric::ublas::vector<std::complex<float> > &z, kiss_fft_cfg dir);
+template boost::numeric::ublas::vector<std::complex<float> > jv_bst::rfft(const boost::numeric::ublas::vector<float> &r, kiss_fftr_cfg dir);
+template boost::numeric::ublas::vector<float>                     jv_bst::irfft(const boost::numeric::ublas::vector<std::complex<float> > &z, kiss_fftr_cfg dir);
+template bool                                                     jv_bst::has_nan(const boost::numeric::ublas::vector<float> &x);
+template bool                                                     jv_bst::has_inf(const boost::numeric::ublas::vector<float> &x);
+
+template void                                                     jv_bst::add(const boost::numeric::ublas::vector<double> &x, double a, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::max(const boost::numeric::ublas::vector<double> &x, double a, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::max(const boost::numeric::ublas::vector<double> &x, const boost::numeric::ublas::vector<double> &y, boost::numeric::ublas::vector<double> &w);
+template void                                                     jv_bst::min(const boost::numeric::ublas::vector<double> &x, double a, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::min(const boost::numeric::ublas::vector<double> &x, const boost::numeric::ublas::vector<double> &y, boost::numeric::ublas::vector<double> &w);
+template double                                                   jv_bst::mean(const boost::numeric::ublas::vector<double> &x);
+template void                                                     jv_bst::real(const boost::numeric::ublas::vector<std::complex<double> > &z, boost::numeric::ublas::vector<double> &r);
+template void                                                     jv_bst::imag(const boost::numeric::ublas::vector<std::complex<double> > &z, boost::numeric::ublas::vector<double> &i);
+template void                                                     jv_bst::abs(const boost::numeric::ublas::vector<std::complex<double> > &z, boost::numeric::ublas::vector<double> &v);
+template void                                                     jv_bst::abs(const boost::numeric::ublas::vector<double> &x, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::angle(const boost::numeric::ublas::vector<std::complex<double> > &z, boost::numeric::ublas::vector<double> &v);
+template void                                                     jv_bst::pow(const boost::numeric::ublas::vector<double> &x, double p, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::sin(const boost::numeric::ublas::vector<double> &t, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::cos(const boost::numeric::ublas::vector<double> &t, boost::numeric::ublas::vector<double> &y);
+template void                                                     jv_bst::wrap_to_pi(const boost::numeric::ublas::vector<double> &t, boost::numeric::ublas::vector<double> &y);
+template boost::numeric::ublas::vector<double>                    jv_bst::zp(const boost::numeric::ublas::vector<double> &x, int len);
+template void                                                     jv_bst::zp(const boost::numeric::ublas::vector<double> &x, int len, boost::numeric::ublas::vector<double> &y);
+template boost::numeric::ublas::vector<std::complex<double> > jv_bst::zp(const boost::numeric::ublas::vector<std::complex<double> > &z, int len);
+template void                                                     jv_bst::zp(const boost::numeric::ublas::vector<std::complex<double> > &z, int len, boost::numeric::ublas::vector<std::complex<double> > &y);
+template void                                                     jv_bst::complex(const boost::numeric::ublas::vector<double> &r, boost::numeric::ublas::vector<std::complex<double> > &z);
+template void                                                     jv_bst::complex(const boost::numeric::ublas::vector<double> &r, const boost::numeric::ublas::vector<double> &i, boost::numeric::ublas::vector<std::complex<double> > &z);
+template void                                                     jv_bst::pol2cart(const boost::numeric::ublas::vector<double> &r, const boost::numeric::ublas::vector<double> &p, boost::numeric::ublas::vector<std::complex<double> > &z);
+template boost::numeric::ublas::vector<std::complex<double> > jv_bst::fft(const boost::numeric::ublas::vector<double> &r, kiss_fft_cfg dir);
+template boost::numeric::ublas::vector<std::complex<double> > jv_bst::fft(const boost::numeric::ublas::vector<std::complex<double> > &z, kiss_fft_cfg dir);
+template boost::numeric::ublas::vector<std::complex<double> > jv_bst::rfft(const boost::numeric::ublas::vector<double> &r, kiss_fftr_cfg dir);
+template boost::numeric::ublas::vector<double>                    jv_bst::irfft(const boost::numeric::ublas::vector<std::complex<double> > &z, kiss_fftr_cfg dir);
+template bool                                                     jv_bst::has_nan(const boost::numeric::ublas::vector<double> &x);
+template bool                                                     jv_bst::has_inf(const boost::numeric::ublas::vector<double> &x);
@@ -26,42 +26,65 @@
 
 #include <kiss_fft/kiss_fft.h>
 #include <kiss_fft/_kiss_fft_guts.h>
+#include <kiss_fft/tools/kiss_fftr.h>
+
+#include "VectorExpressions.h"
 
 namespace jv_bst {
     
-    template <typename T> boost::numeric::ublas::vector<T> add(boost::numeric::ublas::vector<T> x, T a);
+    /* Element-wise operations come in two forms:
+     
+        f(x, ...)           a lazy expression (VectorExpressions.h), evaluated
+                            when assigned; chains fuse into one pass with
+                            jv_bst::noalias(y) = ...
+        f(x, ..., y)        writes into y, which the caller owns
+     
+     The second form only allocates if y has the wrong size, so on the audio
+     thread size y once and reuse it. Element-wise operations whose input and
+     output types match may be called in place, e.g. wrap_to_pi(dp, dp).
+     zp and the fft wrappers return new vectors. */
+    
+    template <typename T> void add(const boost::numeric::ublas::vector<T> &x, T a, boost::numeric::ublas::vector<T> &y);
+    
+    template <typename T> void max(const boost::numeric::ublas::vector<T> &x, T a, boost::numeric::ublas::vector<T> &y);
+    template <typename T> void max(const boost::numeric::ublas::vector<T> &x, const boost::numeric::ublas::vector<T> &y, boost::numeric::ublas::vector<T> &w);
+    template <typename T> void min(const boost::numeric::ublas::vector<T> &x, T a, boost::numeric::ublas::vector<T> &y);
+    template <typename T> void min(const boost::numeric::ublas::vector<T> &x, const boost::numeric::ublas::vector<T> &y, boost::numeric::ublas::vector<T> &w);
     
-    template <typename T> boost::numeric::ublas::vector<T> max(boost::numeric::ublas::vector<T> x, T a);
-    template <typename T> boost::numeric::ublas::vector<T> max(boost::numeric::ublas::vector<T> x, boost::numeric::ublas::vector<T> y);
-    template <typename T> boost::numeric::ublas::vector<T> min(boost::numeric::ublas::vector<T> x, T a);
-    template <typename T> boost::numeric::ublas::vector<T> min(boost::numeric::ublas::vector<T> x, boost::numeric::ublas::vector<T> y);
+    template <typename T> T mean(const boost::numeric::ublas::vector<T> &x);
     
-    template <typename T> T mean(boost::numeric::ublas::vector<T> x);
+    template <typename T> void real(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &r);
+    template <typename T> void imag(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &i);
+    template <typename T> void abs(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &v);
+    template <typename T> void abs(const boost::numeric::ublas::vector<T> &x, boost::numeric::ublas::vector<T> &y);
+    template <typename T> void angle(const boost::numeric::ublas::vector<std::complex<T> > &z, boost::numeric::ublas::vector<T> &v);
     
-    template <typename T> boost::numeric::ublas::vector<T> real(boost::numeric::ublas::vector<std::complex<T> > z);
-    template <typename T> boost::numeric::ublas::vector<T> imag(boost::numeric::ublas::vector<std::complex<T> > z);
-    template <typename T> boost::numeric::ublas::vector<T> abs(boost::numeric::ublas::vector<std::complex<T> > z);
-    template <typename T> boost::numeric::ublas::vector<T> abs(boost::numeric::ublas::vector<T> z);
-    template <typename T> boost::numeric::ublas::vector<T> angle(boost::numeric::ublas::vector<std::complex<T> > z);
+    template <typename T> void pow(const boost::numeric::ublas::vector<T> &x, T p, boost::numeric::ublas::vector<T> &y);
     
-    template <typename T> boost::numeric::ublas::vector<T> pow(boost::numeric::ublas::vector<T> x, T p);
+    template <typename T> void sin(const boost::numeric::ublas::vector<T> &t, boost::numeric::ublas::vector<T> &y);
+    template <typename T> void cos(const boost::numeric::ublas::vector<T> &t, boost::numeric::ublas::vector<T> &y);
+    template <typename T> void wrap_to_pi(const boost::numeric::ublas::vector<T> &t, boost::numeric::ublas::vector<T> &y);
     
-    template <typename T> boost::numeric::ublas::vector<T> sin(boost::numeric::ublas::vector<T> t);
-    template <typename T> boost::numeric::ublas::vector<T> cos(boost::numeric::ublas::vector<T> t);
-    template <typename T> boost::numeric::ublas::vector<T> wrap_to_pi(boost::numeric::ublas::vector<T> t);
+    template <typename T> boost::numeric::ublas::vector<T> zp(const boost::numeric::ublas::vector<T> &x, int len);
+    template <typename T> void zp(const boost::numeric::ublas::vector<T> &x, int len, boost::numeric::ublas::vector<T> &y);
+    template <typename T> boost::numeric::ublas::vector<std::complex<T> > zp(const boost::numeric::ublas::vector<std::complex<T> > &z, int len);
+    template <typename T> void zp(const boost::numeric::ublas::vector<std::complex<T> > &z, int len, boost::numeric::ublas::vector<std::complex<T> > &y);
     
-    template <typename T> boost::numeric::ublas::vector<T> zp(boost::numeric::ublas::vector<T> x, int len);
-    template <typename T> boost::numeric::ublas::vector<std::complex<T> > zp(boost::numeric::ublas::vector<std::complex<T> > z, int len);
+    template <typename T> void complex(const boost::numeric::ublas::vector<T> &r, boost::numeric::ublas::vector<std::complex<T> > &z);
+    template <typename T> void complex(const boost::numeric::ublas::vector<T> &r, const boost::numeric::ublas::vector<T> &i, boost::numeric::ublas::vector<std::complex<T> > &z);
+    template <typename T> void pol2cart(const boost::numeric::ublas::vector<T> &r, const boost::numeric::ublas::vector<T> &p, boost::numeric::ublas::vector<std::complex<T> > &z);
     
-    template <typename T> boost::numeric::ublas::vector<std::complex<T> > complex(boost::numeric::ublas::vector<T> r);
-    template <typename T> boost::numeric::ublas::vector<std::complex<T> > complex(boost::numeric::ublas::vector<T> r, boost::numeric::ublas::vector<T> i);
-    template <typename T> boost::numeric::ublas::vector<std::complex<T> > pol2cart(boost::numeric::ublas::vector<T> r, boost::numeric::ublas::vector<T> i);
+    // allocating convenience wrappers; on the audio thread use RealFFT instead
+    template <typename T> boost::numeric::ublas::vector<std::complex<T> > fft(const boost::numeric::ublas::vector<T> &r, kiss_fft_cfg dir);
+    template <typename T> boost::numeric::ublas::vector<std::complex<T> > fft(const boost::numeric::ublas::vector<std::complex<T> > &z, kiss_fft_cfg dir);
     
-    template <typename T> boost::numeric::ublas::vector<std::complex<T> > fft(boost::numeric::ublas::vector<T> r, kiss_fft_cfg dir);
-    template <typename T> boost::numeric::ublas::vector<std::complex<T> > fft(boost::numeric::ublas::vector<std::complex<T> > z, kiss_fft_cfg dir);
+    // real input of length n_fft -> half-spectrum of length n_fft/2 + 1
+    template <typename T> boost::numeric::ublas::vector<std::complex<T> > rfft(const boost::numeric::ublas::vector<T> &r, kiss_fftr_cfg dir);
+    // half-spectrum of length n_fft/2 + 1 -> real output of length n_fft, scaled by 1/n_fft
+    template <typename T> boost::numeric::ublas::vector<T> irfft(const boost::numeric::ublas::vector<std::complex<T> > &z, kiss_fftr_cfg dir);
     
-    template <typename T> bool has_nan(boost::numeric::ublas::vector<T> x);
-    template <typename T> bool has_inf(boost::numeric::ublas::vector<T> x);
+    template <typename T> bool has_nan(const boost::numeric::ublas::vector<T> &x);
+    template <typename T> bool has_inf(const boost::numeric::ublas::vector<T> &x);
     
     
 //    boost::numeric::ublas::vector<float> real(boost::numeric::ublas::vector<std::complex<float> > z);
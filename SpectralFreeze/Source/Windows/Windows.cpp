@@ -10,31 +10,129 @@
 
 #include "Windows.h"
 
+#include <cmath>
+
 // Generate hann window of length len.
-bst::vector<float> hann(int len)
+void hann(float *w, int len)
 {
-    bst::vector<float> window (len);
-    float N = static_cast<float>(len);
     for (int n = 0; n < len; n++)
     {
-        float fn = static_cast<float>(n);
-        window(n) = pow(sin(M_PI * fn / N), 2.0f);
+        double s = std::sin(M_PI * n / len);
+        w[n] = static_cast<float>(s * s);
     }
-    return window;
 }
 
 // Generate hamming window of length len.
-bst::vector<float> hamming(int len)
+void hamming(float *w, int len)
+{
+    const double a_0 = 0.54;
+    const double a_1 = 1.0 - a_0;
+    for (int n = 0; n < len - 1; n++)
+    {
+        w[n] = static_cast<float>(a_0 + a_1 * std::cos((2.0 * M_PI * n / (len - 1)) + M_PI));
+    }
+    w[len - 1] = w[0];
+}
+
+// Generate 4-term blackman-harris window of length len.
+void blackman_harris(float *w, int len)
+{
+    const double a_0 = 0.35875, a_1 = 0.48829, a_2 = 0.14128, a_3 = 0.01168;
+    for (int n = 0; n < len; n++)
+    {
+        double t = 2.0 * M_PI * n / len;
+        w[n] = static_cast<float>(a_0 - a_1 * std::cos(t) + a_2 * std::cos(2.0 * t) - a_3 * std::cos(3.0 * t));
+    }
+}
+
+// Modified bessel function of the first kind, order 0.
+static double bessel_i0(double x)
+{
+    // power series, to double precision
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; term > 1.0e-16 * sum; k++)
+    {
+        double r = x / (2.0 * k);
+        term *= r * r;
+        sum += term;
+    }
+    return sum;
+}
+
+// Generate kaiser window of length len with shape beta.
+void kaiser(float *w, int len, double beta)
+{
+    double norm = bessel_i0(beta);
+    for (int n = 0; n < len; n++)
+    {
+        double t = 2.0 * n / len - 1.0;
+        w[n] = static_cast<float>(bessel_i0(beta * std::sqrt(1.0 - t * t)) / norm);
+    }
+}
+
+// Generate square root of the hann window of length len.
+void sqrt_hann(float *w, int len)
+{
+    for (int n = 0; n < len; n++)
+    {
+        w[n] = static_cast<float>(std::sin(M_PI * n / len));
+    }
+}
+
+// Generate asymmetric analysis window of length len for synthesis over its
+// last synthesis_len samples.
+void asymmetric_analysis(float *w, int len, int synthesis_len)
+{
+    int M = synthesis_len / 2;
+    int L = len - M;                // length of the rise
+    for (int n = 0; n < L; n++)
+    {
+        w[n] = static_cast<float>(std::sin(M_PI * n / (2 * L)));
+    }
+    for (int n = L; n < len; n++)
+    {
+        int j = n - len + synthesis_len;
+        w[n] = static_cast<float>(std::sin(M_PI * j / synthesis_len));
+    }
+}
+
+// Generate the synthesis window paired with asymmetric_analysis.
+void asymmetric_synthesis(float *w, int len, int synthesis_len)
+{
+    // the analysis fall is already the sqrt of the hann
+    asymmetric_analysis(w, len, synthesis_len);
+    
+    int M = synthesis_len / 2;
+    int L = 2 * len - 2 * M;        // twice the length of the analysis rise
+    for (int n = 0; n < len - synthesis_len; n++)
+    {
+        w[n] = 0.0f;
+    }
+    for (int n = len - synthesis_len; n < len - M; n++)
+    {
+        // hann / analysis over the first half, 0 where the analysis is
+        int j = n - len + synthesis_len;
+        double h = std::sin(M_PI * j / synthesis_len);
+        double a = std::sin(M_PI * n / L);
+        w[n] = (a > 0.0) ? static_cast<float>(h * h / a) : 0.0f;
+    }
+}
+
+// Divide synthesis by what analysis * synthesis sums to when overlap-added.
+void cola_normalize(const float *analysis, const float *synthesis, int len, int hop_size, float *w)
 {
-    bst::vector<float> window (len);
-    float N = static_cast<float>(len-1);
-    float a_0 = 0.54;
-    float a_1 = 1.0 - a_0;
-    for (int n = 0; n < N; n++)
+    for (int r = 0; r < hop_size && r < len; r++)
     {
-        float fn = static_cast<float>(n);
-        window(n) = a_0 + a_1 * cos((2.0 * M_PI * fn / N) + M_PI);
+        // every m = r modulo hop_size overlaps every other
+        double sum = 0.0;
+        for (int m = r; m < len; m += hop_size)
+        {
+            sum += static_cast<double>(analysis[m]) * synthesis[m];
+        }
+        for (int m = r; m < len; m += hop_size)
+        {
+            w[m] = (sum > 0.0) ? static_cast<float>(synthesis[m] / sum) : 0.0f;
+        }
     }
-    window(len-1) = window(0);
-    return window;
 }
@@ -5,18 +5,36 @@
     Created: 12 Mar 2021 3:33:36pm
     Author:  Julian Vanasse
 
+        Window generators. Each writes a window of length len into w, which
+    the caller owns, so none of them allocate; plan_cache keeps the tables
+    engines share.
+
   ==============================================================================
 */
 
 #pragma once
 
-#include <boost/numeric/ublas/vector.hpp>
-#include <boost/numeric/ublas/io.hpp>
-#include <boost/numeric/ublas/assignment.hpp>
-
-namespace bst = boost::numeric::ublas;
+// Generate hann window of length len (periodic).
+void hann(float *w, int len);
+// Generate hamming window of length len (symmetric).
+void hamming(float *w, int len);
+// Generate 4-term blackman-harris window of length len (periodic).
+void blackman_harris(float *w, int len);
+// Generate kaiser window of length len (periodic) with shape beta.
+void kaiser(float *w, int len, double beta);
+// Generate square root of the hann window of length len, for weighted
+// overlap-add: used for analysis and synthesis, the product is a hann.
+void sqrt_hann(float *w, int len);
+// Generate asymmetric analysis window of length len for synthesis over its
+// last synthesis_len samples (even, <= len): a long sqrt hann rise, then
+// the fall of a sqrt hann of length synthesis_len.
+void asymmetric_analysis(float *w, int len, int synthesis_len);
+// Generate the synthesis window paired with asymmetric_analysis: zero before
+// the last synthesis_len samples, where the product of the two is a hann of
+// length synthesis_len.
+void asymmetric_synthesis(float *w, int len, int synthesis_len);
 
-// Generate hann window of length len.
-bst::vector<float> hann(int len);
-// Generate hamming window of length len.
-bst::vector<float> hamming(int len);
+// Divide synthesis by what analysis * synthesis sums to at each sample when
+// overlap-added every hop_size samples, into w (which may be synthesis), so
+// frames windowed by analysis and w sum to 1 (0 where nothing overlaps).
+void cola_normalize(const float *analysis, const float *synthesis, int len, int hop_size, float *w);
@@ -125,19 +125,19 @@ void PhaseVocodeur::init_fft()
 {
     /* Initialize spectral containers and routines */
     
-    // allocate space for input and output
-    fft_in = new kiss_fft_cpx[n_fft];
-    fft_out = new kiss_fft_cpx[n_fft];
+    // allocate space for real input and half-spectrum output
+    fft_in = new kiss_fft_scalar[n_fft];
+    fft_out = new kiss_fft_cpx[num_bins];
     
     // initialize data storage
     
     // Set the memory of (`fft_in`) to 0, specifying in bytes.
-    memset(fft_in, 0, n_fft * sizeof(kiss_fft_cpx));
-    memset(fft_out, 0, n_fft * sizeof(kiss_fft_cpx));
+    memset(fft_in, 0, n_fft * sizeof(kiss_fft_scalar));
+    memset(fft_out, 0, num_bins * sizeof(kiss_fft_cpx));
     
-    // initialize plans
-    fft_forward = kiss_fft_alloc(n_fft, 0, 0, 0);
-    fft_inverse = kiss_fft_alloc(n_fft, 1, 0, 0);
+    // initialize real-input plans
+    fft_forward = kiss_fftr_alloc(n_fft, 0, 0, 0);
+    fft_inverse = kiss_fftr_alloc(n_fft, 1, 0, 0);
 }
 
 /*
@@ -149,8 +149,8 @@ void PhaseVocodeur::init_fft()
 PhaseVocodeur::~PhaseVocodeur()
 {
     /* free spectral resources */
-    kiss_fft_free(fft_forward);
-    kiss_fft_free(fft_inverse);
+    kiss_fftr_free(fft_forward);
+    kiss_fftr_free(fft_inverse);
     delete[] fft_in;
     delete[] fft_out;
 }
@@ -198,6 +198,60 @@ void PhaseVocodeur::advance()
     }
 }
 
+void PhaseVocodeur::process(const float *input, float *output, int num_samples)
+{
+    /* Moves input in contiguous chunks that end at the next hop boundary, so
+       each full buffer channel is transformed once per hop. */
+    auto ola_in_w = ola_in.getArrayOfWritePointers();
+    auto r = ola_out.getArrayOfReadPointers();
+    
+    int n = 0;
+    while (n < num_samples)
+    {
+        // samples until the next buffer channel is full
+        int chunk = num_samples - n;
+        for (int b = 0; b < num_ola_frames; b++)
+        {
+            chunk = std::min(chunk, ola_size - rw[b]);
+        }
+        
+        // write input into all the write buffers
+        for (int b = 0; b < num_ola_frames; b++)
+        {
+            std::copy(input + n, input + n + chunk, ola_in_w[b] + rw[b]);
+        }
+        
+        // sum to output, except the last sample of the chunk
+        float *w = output + n;
+        std::fill(w, w + chunk, 0.0f);
+        for (int b = 0; b < num_ola_frames; b++)
+        {
+            for (int k = 0; k < chunk - 1; k++)
+            {
+                w[k] += r[b][rw[b] + k];
+            }
+        }
+        
+        // process full channels, the last sample reads the new output
+        for (int b = 0; b < num_ola_frames; b++)
+        {
+            if (rw[b] + chunk == ola_size)
+            {
+                spectral_routine(b);
+            }
+            w[chunk - 1] += r[b][rw[b] + chunk - 1];
+        }
+        
+        // advance rw positions
+        for (int b = 0; b < num_ola_frames; b++)
+        {
+            rw[b] = (rw[b] + chunk) % ola_size;
+        }
+        
+        n += chunk;
+    }
+}
+
 /*
  ==============================================================================
  Spectral processing.
@@ -216,16 +270,16 @@ void PhaseVocodeur::spectral_routine(int b)
     apply_window(ola_out_r, ola_out_w);
     // copy into spectral buffers
     clear_cpx();
-    copy_to_cpx(ola_out_r, fft_in, frame_size);
-    // transform
-    kiss_fft(fft_forward, fft_in, fft_out);
+    copy_to_fft(ola_out_r, fft_in, frame_size);
+    // transform (n_fft real -> num_bins complex)
+    kiss_fftr(fft_forward, fft_in, fft_out);
     
     /* DO SOMETHING */
     spectral_processing();
     /* ------------ */
     
     /* BACK TO TIME-DOMAIN */
-    kiss_fft(fft_inverse, fft_out, fft_in);
+    kiss_fftri(fft_inverse, fft_out, fft_in);
     // copy into ola_out
     copy_to_bfr(ola_out_w, fft_in, n_fft);
 }
@@ -287,28 +341,14 @@ void PhaseVocodeur::apply_window(const float *r, float *w)
 /* coordinate conversion */
 void PhaseVocodeur::car2pol(kiss_fft_cpx *cpx_out, float *r, float *p, int len)
 {
-    for (int k = 0; k < len; k++)
-    {
-        r[k] = mag(cpx_out[k].r, cpx_out[k].i);
-        p[k] = ang(cpx_out[k].r, cpx_out[k].i);
-    }
+    // kiss_fft_cpx is laid out as std::complex<float>
+    fast_math::car2pol(reinterpret_cast<const std::complex<float>*>(cpx_out), r, p, len);
 }
 
 void PhaseVocodeur::pol2car(kiss_fft_cpx *cpx_out, float *r, float *p, int len)
 {
-    for (int k = 0; k < len; k++)
-    {
-        cpx_out[k].r = cos(p[k])*r[k]*2.0f;
-        cpx_out[k].i = sin(p[k])*r[k]*2.0f;
-    }
-    // negative frequencies
-    int m = num_bins-2;
-    for (int k = num_bins; k < n_fft; k++)
-    {
-        cpx_out[k].r = cpx_out[m].r;
-        cpx_out[k].i = -cpx_out[m].i;
-        m--;
-    }
+    fast_math::pol2car(r, p, reinterpret_cast<std::complex<float>*>(cpx_out), len, 2.0f);
+    // negative frequencies are implied by kiss_fftri
 }
 
 /*
@@ -319,37 +359,34 @@ void PhaseVocodeur::pol2car(kiss_fft_cpx *cpx_out, float *r, float *p, int len)
 
 void PhaseVocodeur::clear_cpx()
 {
-    /* clear complex kiss_fft buffers */
+    /* clear kiss_fft buffers */
     for (int n = 0; n < n_fft; n++)
     {
-        fft_in[n].r = 0.0f; fft_in[n].i = 0.0f;
-        fft_out[n].r = 0.0f; fft_out[n].i = 0.0f;
+        fft_in[n] = 0.0f;
+    }
+    for (int k = 0; k < num_bins; k++)
+    {
+        fft_out[k].r = 0.0f; fft_out[k].i = 0.0f;
     }
 }
 
-void PhaseVocodeur::copy_to_cpx(float *arr, kiss_fft_cpx *cpx_in, int len)
-{
-    const float *r = const_cast<float *>(arr);
-    copy_to_cpx(r, cpx_in, len);
-}
-
-void PhaseVocodeur::copy_to_cpx(const float *r, kiss_fft_cpx *cpx_in, int len)
+void PhaseVocodeur::copy_to_fft(const float *r, kiss_fft_scalar *real_in, int len)
 {
-    /* copy into real part of fft_in */
+    /* copy into real fft_in */
     for (int n = 0; n < len; n++)
     {
-        cpx_in[n].r = r[n];
+        real_in[n] = r[n];
     }
 
 }
 
-void PhaseVocodeur::copy_to_bfr(float *w, kiss_fft_cpx *cpx_in, int len)
+void PhaseVocodeur::copy_to_bfr(float *w, kiss_fft_scalar *real_in, int len)
 {
-    /* copy real cpx_in to buffer and scale */
+    /* copy real fft output to buffer and scale */
     float fN = static_cast<float>(n_fft);
     for (int n = 0; n < len; n++)
     {
-        w[n] = cpx_in[n].r / fN;
+        w[n] = real_in[n] / fN;
     }
     
 }
@@ -360,6 +397,19 @@ void PhaseVocodeur::copy_to_bfr(float *w, kiss_fft_cpx *cpx_in, int len)
  ==============================================================================
  */
 
+int PhaseVocodeur::get_latency_samples()
+{
+    // a buffer channel is transformed once it holds ola_size inputs, and read
+    // out from the start again, so every input sample comes out ola_size later
+    return ola_size;
+}
+
+int PhaseVocodeur::get_tail_samples()
+{
+    // the last channel holding the last input sample is read out ola_size after it
+    return get_latency_samples() + ola_size;
+}
+
 void PhaseVocodeur::print()
 {
     printf("Phase Vocodeur:\n");
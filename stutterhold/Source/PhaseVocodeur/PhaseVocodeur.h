@@ -23,11 +23,15 @@
 #include <string>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 #include <math.h>
 #include <JuceHeader.h>
 /* fft library */
 //#include "../kiss_fft130/kiss_fft.h"
 #include "../Libraries/kiss_fft130/kiss_fft.h"
+#include "../Libraries/kiss_fft130/tools/kiss_fftr.h"
+/* polar conversion kernels, shared with SpectralFreeze */
+#include "../../../SpectralFreeze/Source/FastMath/FastMath.h"
 
 #define DEFAULT_FRAME_SIZE 256
 #define DEFAULT_HOP_SIZE 128
@@ -49,27 +53,35 @@ public:
     virtual void advance();
     float read_sum();
     
+    /* block operation, equivalent to push(), read_sum(), advance() per sample */
+    virtual void process(const float *input, float *output, int num_samples);
+    
     /* spectral processing */
     virtual void spectral_routine(int b);   // apply windowing, FFT and IFFT to next buffer channel in push( float )
     virtual void spectral_processing();     // manipulating transformed data
     
+    /* delay of the output behind the input, and how long output lasts
+       after the input stops, in samples */
+    int get_latency_samples();
+    int get_tail_samples();
+    
     /* debugging help */
     void print();
     
 //private: ... should be better interface?
 protected:
     /* spectral containers */
-    kiss_fft_cpx* fft_in;
-    kiss_fft_cpx* fft_out;
+    kiss_fft_scalar* fft_in;    // real frame, n_fft
+    kiss_fft_cpx* fft_out;      // half-spectrum, num_bins
     
 // private:
     /* spectral dimension */
     int n_fft {2*DEFAULT_FRAME_SIZE};
     int num_bins {DEFAULT_FRAME_SIZE + 1};
     
-    /* spectral plan */
-    kiss_fft_cfg fft_forward;
-    kiss_fft_cfg fft_inverse;
+    /* spectral plan (real input) */
+    kiss_fftr_cfg fft_forward;
+    kiss_fftr_cfg fft_inverse;
     
     /* time domain dimensions */
     int frame_size {DEFAULT_FRAME_SIZE};
@@ -91,9 +103,8 @@ protected:
     
     /* spectral helpers */
     void clear_cpx();
-    void copy_to_cpx(float *arr, kiss_fft_cpx* fft_in, int len);
-    void copy_to_cpx(const float *r, kiss_fft_cpx* fft_in, int len);
-    void copy_to_bfr(float *w, kiss_fft_cpx* fft_out, int len);
+    void copy_to_fft(const float *r, kiss_fft_scalar* fft_in, int len);
+    void copy_to_bfr(float *w, kiss_fft_scalar* fft_in, int len);
     
     /* coordinate conversion */
     void car2pol(kiss_fft_cpx* cpx_out, float *r, float *p, int len);
@@ -112,17 +123,7 @@ protected:
     
 };
 
-static float mag(float a, float b)
-{
-    return sqrt(pow(a, 2) + pow(b, 2));
-}
-
-static float ang(float a, float b)
-{
-    return atan2(b, a);
-}
-
-static void print_int_vector(std::vector<int> arr)
+inline void print_int_vector(std::vector<int> arr)
 {
     std::vector<int>::iterator it;
     printf("[");
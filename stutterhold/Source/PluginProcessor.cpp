@@ -95,12 +95,18 @@ void StutterholdAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
+    
+    // blocks are passed through unchanged for now, so there is no delay to
+    // report; once the hold runs on a PhaseVocodeur this becomes its
+    // get_latency_samples(), and the tail its get_tail_samples()
+    setLatencySamples (0);
 }
 
 void StutterholdAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    rt_guard::print_violations();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -131,6 +137,7 @@ bool StutterholdAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void StutterholdAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    RT_GUARD_SCOPE("stutterhold::processBlock");
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
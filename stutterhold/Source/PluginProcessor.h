@@ -10,6 +10,8 @@
 
 #include <JuceHeader.h>
 
+#include "../../SpectralFreeze/Source/RealtimeGuard/RealtimeGuard.h"
+
 //==============================================================================
 /**
 */